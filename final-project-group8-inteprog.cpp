@@ -14,9 +14,45 @@ Dave Anthony Sales
 #include <sstream>
 #include <algorithm> // For transform, find, remove_if, find_if
 #include <limits>    // For numeric_limits
-#include <map>       // For inventory allocation in events
+#include <map>       // For ordered report groupings and the allocation map benchmark
 #include <locale>    // For locale
 #include <iomanip>   // For setw, left, right
+#include <cstdint>   // For fixed-width integers in binary snapshots
+#include <cstring>   // For memcpy, memchr
+#include <cstdio>    // For rename, remove
+#include <filesystem> // For snapshot staleness checks
+#include <string_view>
+#include <charconv>  // For from_chars
+#include <unordered_map>
+#include <thread>    // For parallel loading
+#include <atomic>    // For id counters shared by loader threads
+#include <set>       // For the ordered event date index
+#include <queue>     // For best-first name completion
+#include <ctime>     // For the current date in upcoming-event queries
+#include <cmath>     // For log in search ranking
+#include <chrono>    // For scan throughput timing
+#include <functional> // For query result callbacks
+#include <memory>    // For unique_ptr
+#include <optional>  // For slot map storage
+#include <stdexcept> // For length_error
+#include <mutex>     // For interning from loader threads
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h> // SSE2 kernels for case-insensitive scans
+#define HAVE_SSE2 1
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h> // For CreateFileMapping / MapViewOfFile, MoveFileExA
+#include <io.h>      // For _commit
+#else
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close, fsync
+#endif
 
 
 // Add this line to use the std namespace
@@ -35,7 +71,9 @@ class System; // System is now a singleton
 
 // --- Enums ---
 enum class Role { ADMIN, REGULAR_USER, NONE };
-enum class EventStatus { UPCOMING, ONGOING, COMPLETED, CANCELED };
+enum class EventStatus : uint8_t { UPCOMING, ONGOING, COMPLETED, CANCELED };
+const int EVENT_STATUS_COUNT = 4;
+enum class DataTable { USERS, EVENTS, INVENTORY, ATTENDEES }; // One per data file
 
 
 // --- Helper Functions ---
@@ -47,6 +85,332 @@ string toLower(string s) {
 }
 
 
+// ASCII case-insensitive hash and equality, so lowercased keys can be looked up with the
+// text as typed, without building a lowercased copy first
+struct CaseInsensitiveHash {
+    size_t operator()(const string& s) const {
+        size_t hash = 14695981039346656037ULL;
+        for (unsigned char c : s) {
+            hash ^= static_cast<size_t>(tolower(c));
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+};
+struct CaseInsensitiveEqual {
+    bool operator()(const string& a, const string& b) const {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i]))) return false;
+        }
+        return true;
+    }
+};
+
+
+// Splits a data line into fields as views into the line, without copying or exceptions.
+// Delimiters are found with memchr, which the C library vectorizes on common platforms.
+class FieldTokenizer {
+private:
+    string_view rest;
+    char delimiter;
+    bool done;
+
+public:
+    explicit FieldTokenizer(string_view line, char delim = ',') : rest(line), delimiter(delim), done(false) {}
+
+    // Returns false once every field has been consumed
+    bool next(string_view& field) {
+        if (done) return false;
+        const void* hit = rest.empty() ? nullptr : memchr(rest.data(), delimiter, rest.size());
+        if (!hit) {
+            field = rest;
+            rest = string_view();
+            done = true;
+            return true;
+        }
+        size_t pos = static_cast<size_t>(static_cast<const char*>(hit) - rest.data());
+        field = rest.substr(0, pos);
+        rest.remove_prefix(pos + 1);
+        return true;
+    }
+
+    // Everything not yet consumed, delimiters included (for free-text last fields)
+    string_view remainder() {
+        if (done) return string_view();
+        done = true;
+        return rest;
+    }
+
+    // Whole-field integer conversion; surrounding whitespace is allowed, anything else fails
+    static bool toInt(string_view field, int& value) {
+        while (!field.empty() && isspace(static_cast<unsigned char>(field.front()))) field.remove_prefix(1);
+        while (!field.empty() && isspace(static_cast<unsigned char>(field.back()))) field.remove_suffix(1);
+        if (field.empty()) return false;
+        const char* last = field.data() + field.size();
+        auto result = from_chars(field.data(), last, value);
+        return result.ec == errc() && result.ptr == last;
+    }
+};
+
+
+// Reads a whole file into memory; false if it cannot be opened
+bool readWholeFile(const string& filename, string& contents) {
+    ifstream inFile(filename);
+    if (!inFile) return false;
+    contents.assign(istreambuf_iterator<char>(inFile), istreambuf_iterator<char>());
+    return true;
+}
+
+
+// Calls handleLine for every non-empty line of a file read by readWholeFile
+template <typename LineHandler>
+void forEachLine(string_view contents, LineHandler handleLine) {
+    FieldTokenizer lines(contents, '\n');
+    string_view line;
+    while (lines.next(line)) {
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1); // Files copied from Windows
+        if (!line.empty()) handleLine(line);
+    }
+}
+
+
+// Raises an id counter above id; safe while records are being parsed on several threads
+void raiseNextId(atomic<int>& nextId, int id) {
+    int current = nextId.load();
+    while (id >= current && !nextId.compare_exchange_weak(current, id + 1)) {
+    }
+}
+
+
+// While alive, values interned on this thread are also remembered here, so a repeated value
+// is found without taking the string pool's lock. The parallel parsers keep one per chunk.
+class LocalInternTable {
+public:
+    unordered_map<string_view, uint32_t> ids; // Keys view strings owned by the pool
+
+    LocalInternTable() : previous(active) { active = this; }
+    ~LocalInternTable() { active = previous; }
+    LocalInternTable(const LocalInternTable&) = delete;
+    LocalInternTable& operator=(const LocalInternTable&) = delete;
+
+    static LocalInternTable* current() { return active; }
+
+private:
+    LocalInternTable* previous;
+    static inline thread_local LocalInternTable* active = nullptr;
+};
+
+
+// While alive, warnings written through warningStream() on this thread are kept here instead
+// of going straight to cerr, so text from concurrent loaders and parsers does not interleave.
+class LocalWarningLog {
+public:
+    ostringstream text;
+
+    LocalWarningLog() : previous(active) { active = this; }
+    ~LocalWarningLog() { active = previous; }
+    LocalWarningLog(const LocalWarningLog&) = delete;
+    LocalWarningLog& operator=(const LocalWarningLog&) = delete;
+
+    static ostream& stream() { return active ? static_cast<ostream&>(active->text) : cerr; }
+
+private:
+    LocalWarningLog* previous;
+    static inline thread_local LocalWarningLog* active = nullptr;
+};
+inline ostream& warningStream() { return LocalWarningLog::stream(); }
+
+
+// Extra parser threads shared by every parse running at once, so the tables loaded together
+// use about one thread per core between them instead of one per core each
+class ParseWorkerBudget {
+public:
+    static size_t acquire(size_t wanted) {
+        size_t available = spare().load();
+        size_t granted;
+        do {
+            granted = min(wanted, available);
+        } while (!spare().compare_exchange_weak(available, available - granted));
+        return granted;
+    }
+    static void release(size_t count) { spare() += count; }
+
+private:
+    static atomic<size_t>& spare() {
+        static atomic<size_t> threads{ max(1u, thread::hardware_concurrency()) - 1 }; // Callers work too
+        return threads;
+    }
+};
+
+
+// Parses the lines of a loaded file on several threads. The text is split into chunks at
+// line boundaries, each chunk is parsed into its own vector, and the results are joined in
+// file order. parseLine(line, out) appends zero or more records to out. The calling thread
+// parses a chunk itself and borrows the rest from ParseWorkerBudget; warnings from each
+// chunk are passed on to the caller's warningStream() in file order after the join.
+template <typename Record, typename LineParser>
+vector<Record> parseLinesInParallel(string_view contents, LineParser parseLine) {
+    const size_t MIN_CHUNK_BYTES = 256 * 1024; // Smaller files are not worth a thread
+    size_t helpers = ParseWorkerBudget::acquire(contents.size() / MIN_CHUNK_BYTES);
+    size_t chunkCount = helpers + 1;
+
+    vector<string_view> chunks;
+    size_t start = 0;
+    for (size_t i = 1; i <= chunkCount && start < contents.size(); ++i) {
+        size_t end = (i == chunkCount) ? contents.size() : max(start, contents.size() * i / chunkCount);
+        if (end < contents.size()) {
+            size_t newline = contents.find('\n', end);
+            end = (newline == string_view::npos) ? contents.size() : newline + 1;
+        }
+        chunks.push_back(contents.substr(start, end - start));
+        start = end;
+    }
+
+    vector<vector<Record>> parsed(chunks.size());
+    vector<string> warnings(chunks.size());
+    auto parseChunk = [&](size_t index) {
+        LocalInternTable internTable; // Repeated locations and categories skip the pool's lock
+        LocalWarningLog warningLog;
+        forEachLine(chunks[index], [&](string_view line) { parseLine(line, parsed[index]); });
+        warnings[index] = warningLog.text.str();
+    };
+    vector<thread> threads;
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        threads.emplace_back(parseChunk, i);
+    }
+    if (!chunks.empty()) parseChunk(0); // The calling thread takes the first chunk
+    for (auto& t : threads) {
+        t.join();
+    }
+    ParseWorkerBudget::release(helpers);
+    for (const auto& text : warnings) warningStream() << text;
+
+    if (parsed.size() == 1) return std::move(parsed[0]);
+    size_t total = 0;
+    for (const auto& part : parsed) total += part.size();
+    vector<Record> records;
+    records.reserve(total);
+    for (auto& part : parsed) {
+        records.insert(records.end(), make_move_iterator(part.begin()), make_move_iterator(part.end()));
+    }
+    return records;
+}
+
+
+// ASCII case-insensitive comparison of n bytes; lowered must already be lowercase
+inline bool equalsIgnoreCaseAscii(const char* text, const char* lowered, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        char c = text[i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c + ('a' - 'A'));
+        if (c != lowered[i]) return false;
+    }
+    return true;
+}
+
+#ifdef HAVE_SSE2
+// Lowercases the ASCII letters of 16 bytes at once
+inline __m128i foldAsciiBlock(__m128i block) {
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+// ASCII case-insensitive substring test that allocates nothing; loweredNeedle must be lowercase.
+// The SSE2 path compares the needle's first and last bytes against 16 positions per step and
+// only verifies positions where both match.
+bool containsIgnoreCase(string_view haystack, string_view loweredNeedle) {
+    size_t n = loweredNeedle.size();
+    if (n == 0) return true;
+    if (haystack.size() < n) return false;
+    const char* text = haystack.data();
+    const char* needle = loweredNeedle.data();
+    size_t lastStart = haystack.size() - n;
+    size_t i = 0;
+#ifdef HAVE_SSE2
+    const __m128i firstByte = _mm_set1_epi8(needle[0]);
+    const __m128i lastByte = _mm_set1_epi8(needle[n - 1]);
+    for (; i + 16 <= lastStart + 1; i += 16) {
+        __m128i starts = foldAsciiBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)));
+        __m128i ends = foldAsciiBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + n - 1)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(starts, firstByte), _mm_cmpeq_epi8(ends, lastByte))));
+        for (size_t bit = 0; mask != 0; ++bit, mask >>= 1) {
+            if ((mask & 1) && equalsIgnoreCaseAscii(text + i + bit, needle, n)) return true;
+        }
+    }
+#endif
+    for (; i <= lastStart; ++i) {
+        if (equalsIgnoreCaseAscii(text + i, needle, n)) return true;
+    }
+    return false;
+}
+
+
+// Timing of a brute-force scan, to compare against building an index
+struct ScanStats {
+    size_t recordsScanned = 0;
+    size_t threadsUsed = 1;
+    double seconds = 0.0;
+
+    double recordsPerSecond() const { return seconds > 0.0 ? recordsScanned / seconds : 0.0; }
+};
+
+// The record a SlotMap slot (a pointer) or an AttendeeStore slot (a view) refers to
+template <typename T>
+const T& recordOf(T* record) { return *record; }
+template <typename View>
+const View& recordOf(const View& view) { return view; }
+
+// Tests matches(record) for every record of a SlotMap or AttendeeStore, splitting large ones
+// across threads. Returns the slots of the matching records in order. matches must be safe to
+// call concurrently.
+template <typename Records, typename Predicate>
+vector<size_t> parallelScan(const Records& records, Predicate matches, ScanStats& stats) {
+    const size_t MIN_RECORDS_PER_THREAD = 16 * 1024; // Smaller scans are not worth a thread
+    auto started = chrono::steady_clock::now();
+    size_t slots = records.slotCount();
+    size_t workers = max(1u, thread::hardware_concurrency());
+    size_t chunkCount = min(workers, slots / MIN_RECORDS_PER_THREAD + 1);
+
+    vector<vector<size_t>> found(chunkCount);
+    auto scanChunk = [&](size_t chunk) {
+        size_t begin = slots * chunk / chunkCount;
+        size_t end = slots * (chunk + 1) / chunkCount;
+        for (size_t i = begin; i < end; ++i) {
+            auto record = records.atSlot(i);
+            if (record && matches(recordOf(record))) found[chunk].push_back(i);
+        }
+    };
+    vector<thread> threads;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        threads.emplace_back(scanChunk, i);
+    }
+    scanChunk(0); // The calling thread takes the first chunk
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    vector<size_t> positions = std::move(found[0]);
+    for (size_t i = 1; i < found.size(); ++i) {
+        positions.insert(positions.end(), found[i].begin(), found[i].end());
+    }
+    stats.recordsScanned = records.size();
+    stats.threadsUsed = chunkCount;
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    return positions;
+}
+
+void printScanStats(const ScanStats& stats, size_t matchCount) {
+    cout << "Scanned " << stats.recordsScanned << " records on " << stats.threadsUsed << " thread(s) in "
+         << fixed << setprecision(3) << stats.seconds * 1000.0 << " ms ("
+         << setprecision(0) << stats.recordsPerSecond() << " records/sec), " << matchCount << " match(es).\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+
 // Function to get validated string input (ensures not empty)
 string getStringInput(const string& prompt) {
     string input;
@@ -105,256 +469,2319 @@ int getPositiveIntInput(const string& prompt) {
 }
 
 
-// Basic date validation (format-MM-DD)
-bool isValidDate(const string& date) {
-    if (date.length() != 10) return false;
-    if (date[4] != '-' || date[7] != '-') return false;
-    try { //Eception handling for stoi
-        int year = stoi(date.substr(0, 4));
-        int month = stoi(date.substr(5, 2));
-        int day = stoi(date.substr(8, 2));
-        if (year < 1900 || year > 2100) return false;
-        if (month < 1 || month > 12) return false;
-        // Basic day check (not accounting for month/leap year complexities)
-        if (day < 1 || day > 31) return false;
-    } catch (const exception&) {
-        return false;
+// --- Packed Dates and Times ---
+// Event dates are stored as days since 1900-01-01 and times as minutes past midnight, so
+// sorting, range queries and comparisons are integer operations. Text is parsed and
+// formatted only at the edges: input, the data files and display.
+using PackedDate = int32_t;
+using PackedTime = int16_t;
+constexpr PackedDate INVALID_DATE = -1;
+constexpr PackedTime INVALID_TIME = -1;
+constexpr int MIN_YEAR = 1900;
+constexpr int MAX_YEAR = 2100;
+constexpr int MINUTES_PER_DAY = 24 * 60;
+
+constexpr bool isLeapYear(int year) { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+
+// Calendar lookups, filled in at compile time
+struct CalendarTables {
+    int monthStart[2][13];                  // [leap][m]: days in the year before month m + 1; [12] is the year length
+    int yearStart[MAX_YEAR - MIN_YEAR + 2]; // Days from 1900-01-01 to January 1st of each year, plus one past MAX_YEAR
+
+    constexpr CalendarTables() : monthStart(), yearStart() {
+        constexpr int monthLengths[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        for (int leap = 0; leap < 2; ++leap) {
+            for (int m = 0; m < 12; ++m) {
+                monthStart[leap][m + 1] = monthStart[leap][m] + monthLengths[m] + (leap == 1 && m == 1 ? 1 : 0);
+            }
+        }
+        for (int year = MIN_YEAR; year <= MAX_YEAR; ++year) {
+            yearStart[year - MIN_YEAR + 1] = yearStart[year - MIN_YEAR] + (isLeapYear(year) ? 366 : 365);
+        }
     }
-    return true;
+};
+constexpr CalendarTables CALENDAR;
+constexpr PackedDate LAST_DATE = CALENDAR.yearStart[MAX_YEAR - MIN_YEAR + 1] - 1; // 2100-12-31
+static_assert(CALENDAR.monthStart[1][12] == 366 && CALENDAR.yearStart[1] == 365, "calendar tables");
+
+constexpr PackedDate makeDate(int year, int month, int day) {
+    if (year < MIN_YEAR || year > MAX_YEAR || month < 1 || month > 12 || day < 1) return INVALID_DATE;
+    const int* months = CALENDAR.monthStart[isLeapYear(year) ? 1 : 0];
+    if (day > months[month] - months[month - 1]) return INVALID_DATE;
+    return CALENDAR.yearStart[year - MIN_YEAR] + months[month - 1] + day - 1;
+}
+static_assert(makeDate(2024, 2, 29) != INVALID_DATE && makeDate(2023, 2, 29) == INVALID_DATE, "leap years");
+
+// Reads a run of decimal digits; false if text is empty or holds anything else
+constexpr bool readDigits(string_view text, int& value) {
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + (c - '0');
+    }
+    return !text.empty();
 }
 
-
-// Update the time validation to allow military time (00:00 to 24:59)
-bool isValidTime(const string& time) {
-    if (time.length() != 5) return false;
-    if (time[2] != ':') return false;
-    try {
-        int hour = stoi(time.substr(0, 2));
-        int minute = stoi(time.substr(3, 2));
-        
-        // Allow 00:00 to 24:59
-        if (hour < 0 || hour > 24) return false;
-        if (minute < 0 || minute > 59) return false;
-        // Special case: 24:00 is valid, but 24:01-24:59 are not
-        if (hour == 24 && minute != 0) return false;
-    } catch (const exception&) {
-        return false;
+// YYYY-MM-DD between 1900 and 2100, checked against the real month lengths
+PackedDate parseDate(string_view text) {
+    int year = 0, month = 0, day = 0;
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-' || !readDigits(text.substr(0, 4), year) ||
+        !readDigits(text.substr(5, 2), month) || !readDigits(text.substr(8, 2), day)) {
+        return INVALID_DATE;
     }
-    return true;
+    return makeDate(year, month, day);
+}
+// HH:MM from 00:00 to 24:00 (24:00 being midnight at the end of the day)
+PackedTime parseTime(string_view text) {
+    int hour = 0, minute = 0;
+    if (text.size() != 5 || text[2] != ':' || !readDigits(text.substr(0, 2), hour) || !readDigits(text.substr(3, 2), minute) ||
+        hour > 24 || minute > 59 || (hour == 24 && minute != 0)) {
+        return INVALID_TIME;
+    }
+    return static_cast<PackedTime>(hour * 60 + minute);
 }
 
+// Writes value as width zero-padded digits ending just before end
+static void writeDigits(char* end, int value, int width) {
+    for (int i = 0; i < width; ++i, value /= 10) *--end = static_cast<char>('0' + value % 10);
+}
+string formatDate(PackedDate date) {
+    if (date < 0 || date > LAST_DATE) return "N/A";
+    const int* years = CALENDAR.yearStart;
+    int yearIndex = static_cast<int>(upper_bound(years, years + (MAX_YEAR - MIN_YEAR + 2), date) - years) - 1;
+    int dayOfYear = date - years[yearIndex];
+    const int* months = CALENDAR.monthStart[isLeapYear(MIN_YEAR + yearIndex) ? 1 : 0];
+    int month = static_cast<int>(upper_bound(months, months + 13, dayOfYear) - months); // 1-12
+    string text = "0000-00-00";
+    writeDigits(&text[4], MIN_YEAR + yearIndex, 4);
+    writeDigits(&text[7], month, 2);
+    writeDigits(&text[10], dayOfYear - months[month - 1] + 1, 2);
+    return text;
+}
+string formatTime(PackedTime time) {
+    if (time < 0 || time > MINUTES_PER_DAY) return "N/A";
+    string text = "00:00";
+    writeDigits(&text[2], time / 60, 2);
+    writeDigits(&text[5], time % 60, 2);
+    return text;
+}
 
-// --- Class Definitions ---
-// ** User Class (Abstract Base Class) ** Encapsulation
-class User {
-protected:
-    string username;
-    string password;
-    Role role;
-    int userId;
-    static int nextUserId;
+bool isValidDate(const string& date) { return parseDate(date) != INVALID_DATE; }
+bool isValidTime(const string& time) { return parseTime(time) != INVALID_TIME; }
+
+// Orders events by start; -1 if the date or time is invalid. Each day spans MINUTES_PER_DAY + 1
+// keys, so 24:00 sorts last in its own day instead of sharing a key with 00:00 the next day.
+long long eventStartKey(PackedDate date, PackedTime time) {
+    if (date == INVALID_DATE || time == INVALID_TIME) return -1;
+    return static_cast<long long>(date) * (MINUTES_PER_DAY + 1) + time;
+}
+
+
+// --- Compressed Bitmap ---
+inline int popCount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word != 0; word &= word - 1) ++count;
+    return count;
+#endif
+}
+
+// Roaring-style set of 32-bit ids. Ids are grouped by their high 16 bits; each group keeps
+// its low halves in a sorted array while it has at most 4096 of them, and in a 65536-bit
+// bitset once it is denser. Both forms are 8 KB at the switch-over point.
+class RoaringBitmap {
+private:
+    static constexpr size_t ARRAY_LIMIT = 4096;
+    static constexpr size_t BITSET_WORDS = 1024;
+
+    struct Container {
+        vector<uint16_t> values; // Sorted low halves while the container is an array
+        vector<uint64_t> bits;   // BITSET_WORDS words once it is a bitset
+        uint32_t cardinality = 0;
+
+        bool isBitset() const { return !bits.empty(); }
+        bool contains(uint16_t low) const {
+            if (isBitset()) return (bits[low >> 6] >> (low & 63)) & 1;
+            return binary_search(values.begin(), values.end(), low);
+        }
+        bool add(uint16_t low) {
+            if (isBitset()) {
+                uint64_t mask = uint64_t(1) << (low & 63);
+                if (bits[low >> 6] & mask) return false;
+                bits[low >> 6] |= mask;
+            } else {
+                auto pos = lower_bound(values.begin(), values.end(), low);
+                if (pos != values.end() && *pos == low) return false;
+                values.insert(pos, low);
+                if (values.size() > ARRAY_LIMIT) toBitset();
+            }
+            cardinality++;
+            return true;
+        }
+        bool remove(uint16_t low) {
+            if (isBitset()) {
+                uint64_t mask = uint64_t(1) << (low & 63);
+                if (!(bits[low >> 6] & mask)) return false;
+                bits[low >> 6] &= ~mask;
+                cardinality--;
+                if (cardinality <= ARRAY_LIMIT / 2) toArray(); // Hysteresis keeps add/remove at the limit cheap
+            } else {
+                auto pos = lower_bound(values.begin(), values.end(), low);
+                if (pos == values.end() || *pos != low) return false;
+                values.erase(pos);
+                cardinality--;
+            }
+            return true;
+        }
+        void toBitset() {
+            bits.assign(BITSET_WORDS, 0);
+            for (uint16_t low : values) bits[low >> 6] |= uint64_t(1) << (low & 63);
+            vector<uint16_t>().swap(values);
+        }
+        void toArray() {
+            values.clear();
+            values.reserve(cardinality);
+            forEach([&](uint16_t low) { values.push_back(low); });
+            vector<uint64_t>().swap(bits);
+        }
+        void recount() {
+            cardinality = 0;
+            for (uint64_t word : bits) cardinality += popCount(word);
+            if (cardinality <= ARRAY_LIMIT) toArray();
+        }
+        template <typename Visitor>
+        void forEach(Visitor visit) const {
+            if (!isBitset()) {
+                for (uint16_t low : values) visit(low);
+                return;
+            }
+            for (size_t w = 0; w < BITSET_WORDS; ++w) {
+                for (uint64_t word = bits[w]; word != 0; word &= word - 1) {
+                    int bit = popCount((word & (0 - word)) - 1); // Index of the lowest set bit
+                    visit(static_cast<uint16_t>(w * 64 + bit));
+                }
+            }
+        }
+    };
+
+    vector<pair<uint16_t, Container>> containers; // Sorted by high half
+
+    vector<pair<uint16_t, Container>>::iterator lowerBound(uint16_t high) {
+        return lower_bound(containers.begin(), containers.end(), high,
+                           [](const pair<uint16_t, Container>& entry, uint16_t key) { return entry.first < key; });
+    }
+    vector<pair<uint16_t, Container>>::iterator findEntry(uint16_t high) {
+        auto it = lowerBound(high);
+        return (it != containers.end() && it->first == high) ? it : containers.end();
+    }
+    const Container* findContainer(uint16_t high) const {
+        auto it = const_cast<RoaringBitmap*>(this)->findEntry(high);
+        return it == containers.end() ? nullptr : &it->second;
+    }
+
+    static Container intersectContainers(const Container& a, const Container& b) {
+        Container result;
+        if (a.isBitset() && b.isBitset()) {
+            result.bits.resize(BITSET_WORDS);
+            for (size_t w = 0; w < BITSET_WORDS; ++w) result.bits[w] = a.bits[w] & b.bits[w];
+            result.recount();
+        } else if (a.isBitset() || b.isBitset()) {
+            const Container& sparse = a.isBitset() ? b : a;
+            const Container& dense = a.isBitset() ? a : b;
+            for (uint16_t low : sparse.values) {
+                if (dense.contains(low)) result.values.push_back(low);
+            }
+            result.cardinality = static_cast<uint32_t>(result.values.size());
+        } else {
+            set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), back_inserter(result.values));
+            result.cardinality = static_cast<uint32_t>(result.values.size());
+        }
+        return result;
+    }
+    // Size of the intersection of two containers, counted without building it
+    static uint32_t intersectContainerCardinality(const Container& a, const Container& b) {
+        uint32_t count = 0;
+        if (a.isBitset() && b.isBitset()) {
+            for (size_t w = 0; w < BITSET_WORDS; ++w) count += popCount(a.bits[w] & b.bits[w]);
+        } else if (a.isBitset() || b.isBitset()) {
+            const Container& sparse = a.isBitset() ? b : a;
+            const Container& dense = a.isBitset() ? a : b;
+            for (uint16_t low : sparse.values) count += dense.contains(low) ? 1 : 0;
+        } else {
+            size_t i = 0, j = 0;
+            while (i < a.values.size() && j < b.values.size()) {
+                if (a.values[i] < b.values[j]) {
+                    ++i;
+                } else if (b.values[j] < a.values[i]) {
+                    ++j;
+                } else {
+                    ++count; ++i; ++j;
+                }
+            }
+        }
+        return count;
+    }
+    static Container uniteContainers(const Container& a, const Container& b) {
+        Container result;
+        if (!a.isBitset() && !b.isBitset()) {
+            set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), back_inserter(result.values));
+            result.cardinality = static_cast<uint32_t>(result.values.size());
+            if (result.values.size() > ARRAY_LIMIT) result.toBitset();
+            return result;
+        }
+        result.bits.assign(BITSET_WORDS, 0);
+        for (const Container* part : { &a, &b }) {
+            if (part->isBitset()) {
+                for (size_t w = 0; w < BITSET_WORDS; ++w) result.bits[w] |= part->bits[w];
+            } else {
+                for (uint16_t low : part->values) result.bits[low >> 6] |= uint64_t(1) << (low & 63);
+            }
+        }
+        result.recount();
+        return result;
+    }
 
 public:
-    User(string uname, string pwd, Role r);
-    User(int id, string uname, string pwd, Role r);
-    virtual ~User();
+    bool add(uint32_t id) {
+        uint16_t high = static_cast<uint16_t>(id >> 16);
+        auto it = lowerBound(high);
+        if (it == containers.end() || it->first != high) it = containers.emplace(it, high, Container());
+        return it->second.add(static_cast<uint16_t>(id & 0xFFFF));
+    }
+    bool remove(uint32_t id) {
+        auto it = findEntry(static_cast<uint16_t>(id >> 16));
+        if (it == containers.end() || !it->second.remove(static_cast<uint16_t>(id & 0xFFFF))) return false;
+        if (it->second.cardinality == 0) containers.erase(it);
+        return true;
+    }
+    bool contains(uint32_t id) const {
+        const Container* container = findContainer(static_cast<uint16_t>(id >> 16));
+        return container && container->contains(static_cast<uint16_t>(id & 0xFFFF));
+    }
+    uint64_t cardinality() const {
+        uint64_t total = 0;
+        for (const auto& entry : containers) total += entry.second.cardinality;
+        return total;
+    }
+    bool empty() const { return containers.empty(); }
+    void clear() { containers.clear(); }
+
+    // Visits the ids in ascending order
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (const auto& entry : containers) {
+            uint32_t high = static_cast<uint32_t>(entry.first) << 16;
+            entry.second.forEach([&](uint16_t low) { visit(high | low); });
+        }
+    }
+    vector<uint32_t> toVector() const {
+        vector<uint32_t> ids;
+        ids.reserve(static_cast<size_t>(cardinality()));
+        forEach([&](uint32_t id) { ids.push_back(id); });
+        return ids;
+    }
 
-    string getUsername() const { return username; }
-    string getPassword() const { return password; }
-    Role getRole() const { return role; }
-    int getUserId() const { return userId; }
+    // Forward iterator over the ids in ascending order
+    class const_iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = ptrdiff_t;
+        using pointer = const uint32_t*;
+        using reference = uint32_t;
+
+        const_iterator() : owner(nullptr), container(0), position(0) {}
+        const_iterator(const RoaringBitmap* bitmap, size_t index) : owner(bitmap), container(index), position(0) { settle(); }
+
+        uint32_t operator*() const {
+            const auto& entry = owner->containers[container];
+            uint32_t low = entry.second.isBitset() ? position : entry.second.values[position];
+            return (static_cast<uint32_t>(entry.first) << 16) | low;
+        }
+        const_iterator& operator++() { ++position; settle(); return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        bool operator==(const const_iterator& other) const { return container == other.container && position == other.position; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        const RoaringBitmap* owner;
+        size_t container;
+        uint32_t position; // Array index, or bit number in a bitset container
+
+        // Moves to the next id at or after the current position, crossing containers as needed
+        void settle() {
+            while (owner && container < owner->containers.size()) {
+                const Container& current = owner->containers[container].second;
+                if (!current.isBitset()) {
+                    if (position < current.values.size()) return;
+                } else {
+                    for (size_t w = position >> 6; w < BITSET_WORDS; ++w) {
+                        uint64_t word = current.bits[w];
+                        if (w == (position >> 6)) word &= ~uint64_t(0) << (position & 63);
+                        if (word != 0) {
+                            position = static_cast<uint32_t>(w * 64 + popCount((word & (0 - word)) - 1));
+                            return;
+                        }
+                    }
+                }
+                ++container;
+                position = 0;
+            }
+            position = 0; // end()
+        }
+    };
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, containers.size()); }
+
+    static RoaringBitmap intersect(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        size_t i = 0, j = 0;
+        while (i < a.containers.size() && j < b.containers.size()) {
+            if (a.containers[i].first < b.containers[j].first) { ++i; continue; }
+            if (b.containers[j].first < a.containers[i].first) { ++j; continue; }
+            Container both = intersectContainers(a.containers[i].second, b.containers[j].second);
+            if (both.cardinality > 0) result.containers.emplace_back(a.containers[i].first, std::move(both));
+            ++i; ++j;
+        }
+        return result;
+    }
+    // intersect(a, b).cardinality() without allocating the intersection
+    static uint64_t intersectCardinality(const RoaringBitmap& a, const RoaringBitmap& b) {
+        uint64_t total = 0;
+        size_t i = 0, j = 0;
+        while (i < a.containers.size() && j < b.containers.size()) {
+            if (a.containers[i].first < b.containers[j].first) { ++i; continue; }
+            if (b.containers[j].first < a.containers[i].first) { ++j; continue; }
+            total += intersectContainerCardinality(a.containers[i].second, b.containers[j].second);
+            ++i; ++j;
+        }
+        return total;
+    }
+    static RoaringBitmap unite(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        size_t i = 0, j = 0;
+        while (i < a.containers.size() || j < b.containers.size()) {
+            if (j == b.containers.size() || (i < a.containers.size() && a.containers[i].first < b.containers[j].first)) {
+                result.containers.push_back(a.containers[i++]);
+            } else if (i == a.containers.size() || b.containers[j].first < a.containers[i].first) {
+                result.containers.push_back(b.containers[j++]);
+            } else {
+                result.containers.emplace_back(a.containers[i].first, uniteContainers(a.containers[i].second, b.containers[j].second));
+                ++i; ++j;
+            }
+        }
+        return result;
+    }
+};
 
-    void setPassword(const string& newPassword);
 
-    //Abstraction - Virtual Void
-    virtual void displayMenu(System& sys) = 0; // Pure virtual
-    virtual void displayDetails() const = 0; // Pure virtual for displaying user-specific details
-    virtual string toString() const;
-    static User* fromString(const string& str); // Definition after Admin/RegularUser
-    static void initNextId(int id) { if (id >= nextUserId) nextUserId = id + 1;}
+
+// --- Sorted Set Algebra ---
+// Intersection, union and difference of ascending, duplicate-free id vectors. When one side
+// is much smaller its ids are galloped for in the larger one; similar sizes use a block merge
+// (SSE2 where available) that compares four ids against four ids per step.
+const size_t GALLOP_RATIO = 32;
+
+// First position at or after from whose value is >= target, by doubling steps then binary search
+inline size_t gallopTo(const vector<int>& values, size_t from, int target) {
+    size_t step = 1, low = from, high = from;
+    while (high < values.size() && values[high] < target) {
+        low = high + 1;
+        high += step;
+        step *= 2;
+    }
+    return static_cast<size_t>(lower_bound(values.begin() + low, values.begin() + min(high, values.size()), target) - values.begin());
+}
+
+vector<int> intersectSorted(const vector<int>& a, const vector<int>& b) {
+    const vector<int>& small = a.size() <= b.size() ? a : b;
+    const vector<int>& large = a.size() <= b.size() ? b : a;
+    vector<int> result;
+    if (small.empty()) return result;
+    size_t i = 0, j = 0;
+    if (large.size() / small.size() >= GALLOP_RATIO) {
+        for (int id : small) {
+            j = gallopTo(large, j, id);
+            if (j == large.size()) break;
+            if (large[j] == id) result.push_back(id);
+        }
+        return result;
+    }
+#ifdef HAVE_SSE2
+    // Each step compares a block of four from small against all four rotations of a block
+    // from large, then advances whichever block ends lower (or both)
+    while (i + 4 <= small.size() && j + 4 <= large.size()) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(small.data() + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(large.data() + j));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(x, y), _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(1, 0, 3, 2))), _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(2, 1, 0, 3)))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(hits));
+        for (int k = 0; k < 4; ++k) {
+            if (mask & (1 << k)) result.push_back(small[i + k]);
+        }
+        int lastSmall = small[i + 3], lastLarge = large[j + 3];
+        if (lastSmall <= lastLarge) i += 4;
+        if (lastLarge <= lastSmall) j += 4;
+    }
+#endif
+    while (i < small.size() && j < large.size()) {
+        if (small[i] < large[j]) ++i;
+        else if (large[j] < small[i]) ++j;
+        else { result.push_back(small[i]); ++i; ++j; }
+    }
+    return result;
+}
+
+vector<int> uniteSorted(const vector<int>& a, const vector<int>& b) {
+    vector<int> result;
+    result.reserve(a.size() + b.size());
+    set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(result));
+    return result;
+}
+
+// Ids in a that are not in b
+vector<int> subtractSorted(const vector<int>& a, const vector<int>& b) {
+    vector<int> result;
+    if (!a.empty() && b.size() / a.size() >= GALLOP_RATIO) {
+        size_t j = 0;
+        for (int id : a) {
+            j = gallopTo(b, j, id);
+            if (j == b.size() || b[j] != id) result.push_back(id);
+        }
+        return result;
+    }
+    set_difference(a.begin(), a.end(), b.begin(), b.end(), back_inserter(result));
+    return result;
+}
+
+
+// --- Attendee Set ---
+// Ordered set of attendee ids for one event. Small events keep a sorted vector (binary
+// search, four bytes per id); past LARGE_THRESHOLD ids the set moves to a RoaringBitmap,
+// so bulk registration into a large event stays cheap per insert.
+class AttendeeSet {
+private:
+    vector<int> small;
+    RoaringBitmap large;
+    size_t count = 0;
+    bool isLarge = false;
+
+public:
+    static constexpr size_t LARGE_THRESHOLD = 512;
+
+    class const_iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = int;
+        using difference_type = ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        const_iterator(vector<int>::const_iterator it) : inSmall(it), fromBitmap(false) {}
+        const_iterator(RoaringBitmap::const_iterator it) : inLarge(it), fromBitmap(true) {}
+
+        int operator*() const { return fromBitmap ? static_cast<int>(*inLarge) : *inSmall; }
+        const_iterator& operator++() { if (fromBitmap) ++inLarge; else ++inSmall; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        bool operator==(const const_iterator& other) const { return fromBitmap ? inLarge == other.inLarge : inSmall == other.inSmall; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        vector<int>::const_iterator inSmall;
+        RoaringBitmap::const_iterator inLarge;
+        bool fromBitmap;
+    };
+
+    const_iterator begin() const { return isLarge ? const_iterator(large.begin()) : const_iterator(small.begin()); }
+    const_iterator end() const { return isLarge ? const_iterator(large.end()) : const_iterator(small.end()); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    bool contains(int id) const {
+        return isLarge ? large.contains(static_cast<uint32_t>(id)) : binary_search(small.begin(), small.end(), id);
+    }
+    // Returns false if the id was already present
+    bool insert(int id) {
+        if (isLarge) {
+            if (!large.add(static_cast<uint32_t>(id))) return false;
+        } else {
+            auto pos = lower_bound(small.begin(), small.end(), id);
+            if (pos != small.end() && *pos == id) return false;
+            small.insert(pos, id);
+            if (small.size() > LARGE_THRESHOLD) {
+                for (int value : small) large.add(static_cast<uint32_t>(value));
+                vector<int>().swap(small);
+                isLarge = true;
+            }
+        }
+        count++;
+        return true;
+    }
+    // Returns false if the id was not present
+    bool erase(int id) {
+        if (isLarge) {
+            if (!large.remove(static_cast<uint32_t>(id))) return false;
+            count--;
+            if (count < LARGE_THRESHOLD / 2) { // Shrink back well below the threshold
+                small.assign(begin(), end());
+                large.clear();
+                isLarge = false;
+            }
+            return true;
+        }
+        auto pos = lower_bound(small.begin(), small.end(), id);
+        if (pos == small.end() || *pos != id) return false;
+        small.erase(pos);
+        count--;
+        return true;
+    }
+    void clear() {
+        small.clear();
+        large.clear();
+        count = 0;
+        isLarge = false;
+    }
+    // Replaces the contents with ids in any order (duplicates are dropped)
+    void assign(vector<int> ids) {
+        clear();
+        sort(ids.begin(), ids.end());
+        ids.erase(unique(ids.begin(), ids.end()), ids.end());
+        if (ids.size() > LARGE_THRESHOLD) {
+            for (int id : ids) large.add(static_cast<uint32_t>(id));
+            isLarge = true;
+        } else {
+            small = std::move(ids);
+        }
+        count = isLarge ? static_cast<size_t>(large.cardinality()) : small.size();
+    }
+    vector<int> toVector() const { return vector<int>(begin(), end()); }
 };
-int User::nextUserId = 1;
 
 
 
-// ** Admin Class ** Inheritance from User
-class Admin : public User {
+// --- Slot Map ---
+// Record storage that never moves a live record. Records sit in fixed-size pages that are
+// never reallocated, and erased slots are recycled by later inserts. A Handle names a slot
+// and the generation it was issued for, so a handle to an erased record resolves to nullptr
+// rather than to whatever reused the slot. Iteration visits live records in slot order.
+// Erasing only tombstones the slot; compact() destroys tombstoned records in one batch and
+// frees their slots, so deletes stay O(1) and never touch other records.
+template <typename T>
+class SlotMap {
 public:
-    Admin(string uname, string pwd);
-    Admin(int id, string uname, string pwd);
-    void displayMenu(System& sys) override;
-    void displayDetails() const override; // Implementation for Admin
+    struct Handle {
+        uint32_t index = numeric_limits<uint32_t>::max();
+        uint32_t generation = 0;
+    };
+
 private:
-    void adminUserManagementMenu(System& sys);
-    void adminEventManagementMenu(System& sys);
-    void adminAttendeeManagementMenu(System& sys);
-    void adminInventoryManagementMenu(System& sys);
-    void adminDataExportMenu(System& sys);
-};
+    static constexpr size_t PAGE_SIZE = 256;
+    struct Slot {
+        optional<T> value;
+        uint32_t generation = 0;
+        bool tombstone = false; // Erased, awaiting compact()
+    };
+    vector<unique_ptr<Slot[]>> pages;
+    vector<uint32_t> freeSlots;
+    vector<uint32_t> tombstones;
+    size_t slotsUsed = 0; // Slots handed out so far (free ones included)
+    size_t liveCount = 0;
+
+    Slot& slot(size_t index) { return pages[index / PAGE_SIZE][index % PAGE_SIZE]; }
+    const Slot& slot(size_t index) const { return pages[index / PAGE_SIZE][index % PAGE_SIZE]; }
+    static bool isLive(const Slot& target) { return target.value && !target.tombstone; }
+
+    template <typename Owner, typename Value>
+    class Iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        Iterator(Owner* map, size_t index) : owner(map), position(index) { skipFree(); }
+        Value& operator*() const { return *owner->slot(position).value; }
+        Value* operator->() const { return &*owner->slot(position).value; }
+        Iterator& operator++() { ++position; skipFree(); return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+        bool operator==(const Iterator& other) const { return position == other.position; }
+        bool operator!=(const Iterator& other) const { return position != other.position; }
+        Handle handle() const { return owner->handleAt(position); }
+
+    private:
+        Owner* owner;
+        size_t position;
+        void skipFree() {
+            while (position < owner->slotsUsed && !owner->isLive(owner->slot(position))) ++position;
+        }
+    };
 
+public:
+    using iterator = Iterator<SlotMap, T>;
+    using const_iterator = Iterator<const SlotMap, const T>;
+
+    Handle insert(T value) {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (slotsUsed % PAGE_SIZE == 0) pages.push_back(make_unique<Slot[]>(PAGE_SIZE));
+            index = static_cast<uint32_t>(slotsUsed++);
+        }
+        Slot& target = slot(index);
+        target.value.emplace(std::move(value));
+        ++liveCount;
+        return Handle{ index, target.generation };
+    }
+    bool erase(Handle handle) {
+        if (!get(handle)) return false;
+        Slot& target = slot(handle.index);
+        target.tombstone = true;
+        ++target.generation; // Outstanding handles to this record stop resolving
+        tombstones.push_back(handle.index);
+        --liveCount;
+        return true;
+    }
+    // Destroys the tombstoned records and makes their slots reusable; O(tombstones)
+    void compact() {
+        for (uint32_t index : tombstones) {
+            Slot& target = slot(index);
+            target.value.reset();
+            target.tombstone = false;
+            freeSlots.push_back(index);
+        }
+        tombstones.clear();
+    }
+    size_t tombstoneCount() const { return tombstones.size(); }
+    T* get(Handle handle) {
+        if (handle.index >= slotsUsed) return nullptr;
+        Slot& target = slot(handle.index);
+        return (target.generation == handle.generation && isLive(target)) ? &*target.value : nullptr;
+    }
+    const T* get(Handle handle) const { return const_cast<SlotMap*>(this)->get(handle); }
+
+    size_t size() const { return liveCount; }
+    bool empty() const { return liveCount == 0; }
+
+    // Slot positions, for partitioned scans: atSlot is nullptr for a free slot
+    size_t slotCount() const { return slotsUsed; }
+    T* atSlot(size_t index) { return isLive(slot(index)) ? &*slot(index).value : nullptr; }
+    const T* atSlot(size_t index) const { return isLive(slot(index)) ? &*slot(index).value : nullptr; }
+    Handle handleAt(size_t index) const { return Handle{ static_cast<uint32_t>(index), slot(index).generation }; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, slotsUsed); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slotsUsed); }
+};
+
+
+
+// --- Flat Small Map ---
+// Map kept as a sorted array of pairs. Lookups are a binary search over contiguous memory,
+// and the first InlineCapacity entries live inside the object, so a map with a few entries
+// allocates nothing. Past that, every entry moves to one heap array. Like vector's,
+// iterators and references are invalidated by insertions and erasures.
+template <typename Key, typename Value, size_t InlineCapacity = 4>
+class FlatMap {
+public:
+    using value_type = pair<Key, Value>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+private:
+    value_type inlineItems[InlineCapacity];
+    vector<value_type> heapItems; // All entries, once there have been more than InlineCapacity
+    size_t count = 0;
+    bool onHeap = false;
+
+    value_type* items() { return onHeap ? heapItems.data() : inlineItems; }
+    const value_type* items() const { return onHeap ? heapItems.data() : inlineItems; }
+    iterator lowerBound(const Key& key) {
+        return lower_bound(begin(), end(), key, [](const value_type& entry, const Key& k) { return entry.first < k; });
+    }
+    const_iterator lowerBound(const Key& key) const {
+        return lower_bound(begin(), end(), key, [](const value_type& entry, const Key& k) { return entry.first < k; });
+    }
+    iterator insertAt(size_t index, const Key& key) {
+        if (!onHeap && count == InlineCapacity) {
+            heapItems.assign(make_move_iterator(inlineItems), make_move_iterator(inlineItems + count));
+            onHeap = true;
+        }
+        if (onHeap) {
+            heapItems.insert(heapItems.begin() + index, value_type(key, Value()));
+        } else {
+            move_backward(inlineItems + index, inlineItems + count, inlineItems + count + 1);
+            inlineItems[index] = value_type(key, Value());
+        }
+        ++count;
+        return items() + index;
+    }
+
+public:
+    Value& operator[](const Key& key) {
+        iterator it = lowerBound(key);
+        if (it != end() && it->first == key) return it->second;
+        return insertAt(static_cast<size_t>(it - begin()), key)->second;
+    }
+    iterator find(const Key& key) {
+        iterator it = lowerBound(key);
+        return (it != end() && it->first == key) ? it : end();
+    }
+    const_iterator find(const Key& key) const {
+        const_iterator it = lowerBound(key);
+        return (it != end() && it->first == key) ? it : end();
+    }
+    iterator erase(iterator position) {
+        size_t index = static_cast<size_t>(position - begin());
+        if (onHeap) {
+            heapItems.erase(heapItems.begin() + index);
+        } else {
+            move(position + 1, end(), position);
+        }
+        --count;
+        return items() + index;
+    }
+    size_t erase(const Key& key) {
+        iterator it = find(key);
+        if (it == end()) return 0;
+        erase(it);
+        return 1;
+    }
+    void clear() {
+        heapItems.clear();
+        count = 0;
+        onHeap = false;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    iterator begin() { return items(); }
+    iterator end() { return items() + count; }
+    const_iterator begin() const { return items(); }
+    const_iterator end() const { return items() + count; }
+};
+
+
+
+// --- String Interning ---
+// Stores each distinct value once and hands out small ids for it. Values are never removed,
+// so an id and the string it names stay valid for the whole run. Any thread may intern;
+// lookup() takes no lock, because a value is stored in a block that never moves before its
+// id is handed out, and only readers that hold the id can ask for it.
+class StringPool {
+private:
+    static constexpr uint32_t BLOCK_SIZE = 4096;
+    static constexpr uint32_t MAX_BLOCKS = 16384; // Room for 64M distinct values
+    unique_ptr<string[]> blocks[MAX_BLOCKS];      // Id -> value, allocated a block at a time
+    atomic<uint32_t> count{ 0 };
+    unordered_map<string_view, uint32_t> ids;     // Keys view the stored values; guarded by internMutex
+    mutex internMutex;
+
+    StringPool() { intern(""); } // Id 0 is the empty string
+
+public:
+    // The pool every InternedString field draws from
+    static StringPool& shared() {
+        static StringPool pool;
+        return pool;
+    }
+
+    uint32_t intern(string_view value) {
+        LocalInternTable* local = LocalInternTable::current();
+        if (local) {
+            auto seen = local->ids.find(value);
+            if (seen != local->ids.end()) return seen->second;
+        }
+        uint32_t id;
+        {
+            lock_guard<mutex> lock(internMutex);
+            auto it = ids.find(value);
+            if (it != ids.end()) {
+                id = it->second;
+            } else {
+                id = count.load(memory_order_relaxed);
+                if (id / BLOCK_SIZE >= MAX_BLOCKS) throw length_error("StringPool is full");
+                unique_ptr<string[]>& block = blocks[id / BLOCK_SIZE];
+                if (!block) block = make_unique<string[]>(BLOCK_SIZE);
+                block[id % BLOCK_SIZE] = string(value);
+                ids.emplace(block[id % BLOCK_SIZE], id);
+                count.store(id + 1, memory_order_release);
+            }
+        }
+        if (local) local->ids.emplace(lookup(id), id);
+        return id;
+    }
+    const string& lookup(uint32_t id) const { return blocks[id / BLOCK_SIZE][id % BLOCK_SIZE]; }
+    size_t size() const { return count.load(memory_order_acquire); }
+};
+
+// A string field kept as an id into StringPool::shared(). Copies are four bytes and equal
+// values compare as integers; str() gives the text back.
+class InternedString {
+private:
+    uint32_t id = 0;
+
+public:
+    InternedString() = default;
+    explicit InternedString(string_view value) : id(StringPool::shared().intern(value)) {}
+
+    const string& str() const { return StringPool::shared().lookup(id); }
+    operator const string&() const { return str(); }
+    uint32_t poolId() const { return id; }
+    bool operator==(const InternedString& other) const { return id == other.id; }
+    bool operator!=(const InternedString& other) const { return id != other.id; }
+};
+inline ostream& operator<<(ostream& out, const InternedString& value) { return out << value.str(); }
+
+
+
+// --- Class Definitions ---
+// ** User Class (Abstract Base Class) ** Encapsulation
+class User {
+protected:
+    string username;
+    string password;
+    Role role;
+    int userId;
+    static atomic<int> nextUserId;
+
+public:
+    User(string uname, string pwd, Role r);
+    User(int id, string uname, string pwd, Role r);
+    virtual ~User();
+
+    string getUsername() const { return username; }
+    string getPassword() const { return password; }
+    Role getRole() const { return role; }
+    int getUserId() const { return userId; }
+
+    void setPassword(const string& newPassword);
+
+    //Abstraction - Virtual Void
+    virtual void displayMenu(System& sys) = 0; // Pure virtual
+    virtual void displayDetails() const = 0; // Pure virtual for displaying user-specific details
+    virtual string toString() const;
+    static User* fromString(string_view str); // Definition after Admin/RegularUser
+    static User* create(int id, string uname, string pwd, Role role); // nullptr for unknown roles
+    static void initNextId(int id) { raiseNextId(nextUserId, id); }
+};
+atomic<int> User::nextUserId{1};
+
+
+
+// ** Admin Class ** Inheritance from User
+class Admin : public User {
+public:
+    Admin(string uname, string pwd);
+    Admin(int id, string uname, string pwd);
+    void displayMenu(System& sys) override;
+    void displayDetails() const override; // Implementation for Admin
+private:
+    void adminUserManagementMenu(System& sys);
+    void adminEventManagementMenu(System& sys);
+    void adminAttendeeManagementMenu(System& sys);
+    void adminInventoryManagementMenu(System& sys);
+    void adminDataExportMenu(System& sys);
+};
+
+
+// ** RegularUser Class ** Inheritance from User
+class RegularUser : public User {
+public:
+    RegularUser(string uname, string pwd);
+    RegularUser(int id, string uname, string pwd);
+    void displayMenu(System& sys) override;
+    void displayDetails() const override; // Implementation for RegularUser
+};
+
+
+
+// ** Attendee Class **
+class Attendee {
+public:
+    int attendeeId;
+    string name;
+    string contactInfo;
+    int eventIdRegisteredFor;
+    bool isCheckedIn;
+    int userId; // Account that owns this registration (0 if unknown)
+    static atomic<int> nextAttendeeId;
+
+    Attendee(string n, string contact, int eventId, int ownerId = 0);
+    Attendee(int id, string n, string contact, int eventId, bool checkedInStatus, int ownerId = 0);
+    void displayDetails() const;
+    string toString() const;
+    static Attendee fromString(string_view str);
+    static void initNextId(int id) { raiseNextId(nextAttendeeId, id); }
+};
+atomic<int> Attendee::nextAttendeeId{1};
+
+// ** Attendee Store **
+// Attendee records kept column by column: ids, event ids and owner ids in dense int arrays,
+// check-in state in a packed bitset, and names and contact info as ranges of one string
+// arena. Counting check-ins or finding an event's records reads a few dense arrays instead
+// of whole records. Slots and handles behave like SlotMap's, tombstones included.
+class AttendeeView;
+class AttendeeRef;
+
+class AttendeeStore {
+public:
+    struct Handle {
+        uint32_t index = numeric_limits<uint32_t>::max();
+        uint32_t generation = 0;
+    };
+
+private:
+    friend class AttendeeView;
+    friend class AttendeeRef;
+
+    struct TextRange {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+    vector<int> attendeeIds;
+    vector<int> eventIds;
+    vector<int> userIds;
+    vector<TextRange> names;
+    vector<TextRange> contacts;
+    vector<uint32_t> generations;
+    vector<uint64_t> liveBits; // Slot holds a record that has not been erased
+    vector<uint64_t> checkedInBits;
+    string arena;              // Every name and contact, back to back
+    size_t arenaGarbage = 0;   // Arena bytes no record refers to any more
+    vector<uint32_t> freeSlots;
+    vector<uint32_t> tombstones;
+    size_t liveCount = 0;
+
+    static bool testBit(const vector<uint64_t>& bits, size_t index) { return (bits[index / 64] >> (index % 64)) & 1; }
+    static void setBit(vector<uint64_t>& bits, size_t index, bool value) {
+        uint64_t mask = uint64_t(1) << (index % 64);
+        if (value) bits[index / 64] |= mask; else bits[index / 64] &= ~mask;
+    }
+    string_view text(TextRange range) const { return string_view(arena).substr(range.offset, range.length); }
+    void replaceText(TextRange& range, string_view value) {
+        arenaGarbage += range.length;
+        range.offset = static_cast<uint32_t>(arena.size());
+        range.length = static_cast<uint32_t>(value.size());
+        arena.append(value.data(), value.size());
+    }
+    void assign(size_t index, const Attendee& attendee) {
+        attendeeIds[index] = attendee.attendeeId;
+        eventIds[index] = attendee.eventIdRegisteredFor;
+        userIds[index] = attendee.userId;
+        setBit(checkedInBits, index, attendee.isCheckedIn);
+        replaceText(names[index], attendee.name);
+        replaceText(contacts[index], attendee.contactInfo);
+    }
+    // Copies the live names and contacts into a fresh arena, dropping the garbage
+    void repackArena() {
+        string packed;
+        packed.reserve(arena.size() - arenaGarbage);
+        auto keep = [&](TextRange& range) {
+            uint32_t offset = static_cast<uint32_t>(packed.size());
+            packed.append(arena, range.offset, range.length);
+            range.offset = offset;
+        };
+        for (size_t i = 0; i < attendeeIds.size(); ++i) {
+            keep(names[i]);
+            keep(contacts[i]);
+        }
+        arena.swap(packed);
+        arenaGarbage = 0;
+    }
+
+    template <typename Owner, typename View>
+    class Iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = View;
+        using difference_type = ptrdiff_t;
+        struct Arrow { // it->field() on a view made on the fly
+            View view;
+            const View* operator->() const { return &view; }
+        };
+        using pointer = Arrow;
+        using reference = View;
+
+        Iterator(Owner* store, size_t index) : owner(store), position(index) { skipFree(); }
+        View operator*() const { return View(owner, position); }
+        Arrow operator->() const { return Arrow{ View(owner, position) }; }
+        Iterator& operator++() { ++position; skipFree(); return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+        bool operator==(const Iterator& other) const { return position == other.position; }
+        bool operator!=(const Iterator& other) const { return position != other.position; }
+        Handle handle() const { return owner->handleAt(position); }
+
+    private:
+        Owner* owner;
+        size_t position;
+        void skipFree() {
+            while (position < owner->slotCount() && !owner->isLive(position)) ++position;
+        }
+    };
+
+public:
+    using iterator = Iterator<AttendeeStore, AttendeeRef>;
+    using const_iterator = Iterator<const AttendeeStore, AttendeeView>;
+
+    Handle insert(const Attendee& attendee) {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = static_cast<uint32_t>(attendeeIds.size());
+            attendeeIds.push_back(0);
+            eventIds.push_back(0);
+            userIds.push_back(0);
+            names.emplace_back();
+            contacts.emplace_back();
+            generations.push_back(0);
+            if (index % 64 == 0) {
+                liveBits.push_back(0);
+                checkedInBits.push_back(0);
+            }
+        }
+        assign(index, attendee);
+        setBit(liveBits, index, true);
+        ++liveCount;
+        return Handle{ index, generations[index] };
+    }
+    bool erase(Handle handle) {
+        if (!isCurrent(handle)) return false;
+        setBit(liveBits, handle.index, false);
+        ++generations[handle.index]; // Outstanding handles to this record stop resolving
+        tombstones.push_back(handle.index);
+        --liveCount;
+        return true;
+    }
+    // Frees the tombstoned slots, and repacks the arena once half of it is garbage
+    void compact() {
+        for (uint32_t index : tombstones) {
+            arenaGarbage += names[index].length + contacts[index].length;
+            names[index] = TextRange();
+            contacts[index] = TextRange();
+            setBit(checkedInBits, index, false);
+            freeSlots.push_back(index);
+        }
+        tombstones.clear();
+        if (arenaGarbage * 2 > arena.size()) repackArena();
+    }
+    size_t tombstoneCount() const { return tombstones.size(); }
+    bool isCurrent(Handle handle) const {
+        return handle.index < attendeeIds.size() && generations[handle.index] == handle.generation && isLive(handle.index);
+    }
+    AttendeeRef get(Handle handle);
+    AttendeeView get(Handle handle) const;
+
+    size_t size() const { return liveCount; }
+    bool empty() const { return liveCount == 0; }
+
+    // Slot positions, for partitioned scans: atSlot is an empty view for a free slot
+    size_t slotCount() const { return attendeeIds.size(); }
+    bool isLive(size_t index) const { return testBit(liveBits, index); }
+    AttendeeView atSlot(size_t index) const;
+    Handle handleAt(size_t index) const { return Handle{ static_cast<uint32_t>(index), generations[index] }; }
+
+    // Calls visit(slot) for each live, checked-in record, skipping 64 slots per empty word
+    template <typename Visit>
+    void forEachCheckedIn(Visit visit) const {
+        for (size_t w = 0; w < liveBits.size(); ++w) {
+            for (uint64_t word = liveBits[w] & checkedInBits[w]; word != 0; word &= word - 1) {
+                visit(w * 64 + popCount((word & (0 - word)) - 1));
+            }
+        }
+    }
+    // Live, checked-in records among the given slots (e.g. one event's registrations): the
+    // slots are folded into one mask per word and counted against the bitsets with popcount
+    size_t checkedInCount(vector<uint32_t> slots) const {
+        sort(slots.begin(), slots.end());
+        size_t count = 0;
+        for (size_t i = 0; i < slots.size();) {
+            size_t w = slots[i] / 64;
+            uint64_t mask = 0;
+            for (; i < slots.size() && slots[i] / 64 == w; ++i) mask |= uint64_t(1) << (slots[i] % 64);
+            if (w < liveBits.size()) count += popCount(mask & liveBits[w] & checkedInBits[w]);
+        }
+        return count;
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, slotCount()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slotCount()); }
+};
+
+// Read access to one record of an AttendeeStore. A view stays usable until its record is
+// erased; the string_views it returns only until the store is next modified.
+class AttendeeView {
+public:
+    AttendeeView() = default;
+    AttendeeView(const AttendeeStore* owner, size_t index) : store(owner), slot(index) {}
+
+    explicit operator bool() const { return store != nullptr; }
+
+    int attendeeId() const { return store->attendeeIds[slot]; }
+    string_view name() const { return store->text(store->names[slot]); }
+    string_view contactInfo() const { return store->text(store->contacts[slot]); }
+    int eventIdRegisteredFor() const { return store->eventIds[slot]; }
+    bool isCheckedIn() const { return AttendeeStore::testBit(store->checkedInBits, slot); }
+    int userId() const { return store->userIds[slot]; }
+
+    Attendee toAttendee() const {
+        return Attendee(attendeeId(), string(name()), string(contactInfo()), eventIdRegisteredFor(), isCheckedIn(), userId());
+    }
+    void displayDetails() const { toAttendee().displayDetails(); }
+    string toString() const { return toAttendee().toString(); }
+
+protected:
+    const AttendeeStore* store = nullptr;
+    size_t slot = 0;
+};
+
+// Read-write access to one record of an AttendeeStore
+class AttendeeRef : public AttendeeView {
+public:
+    AttendeeRef() = default;
+    AttendeeRef(AttendeeStore* owner, size_t index) : AttendeeView(owner, index) {}
+
+    void checkIn() const;
+    void setCheckedIn(bool checkedIn) const { AttendeeStore::setBit(columns().checkedInBits, slot, checkedIn); }
+    void setContactInfo(string_view contact) const { columns().replaceText(columns().contacts[slot], contact); }
+    void setUserId(int ownerId) const { columns().userIds[slot] = ownerId; }
+    void assign(const Attendee& attendee) const { columns().assign(slot, attendee); }
+
+private:
+    AttendeeStore& columns() const { return const_cast<AttendeeStore&>(*store); }
+};
+
+inline AttendeeRef AttendeeStore::get(Handle handle) {
+    return isCurrent(handle) ? AttendeeRef(this, handle.index) : AttendeeRef();
+}
+inline AttendeeView AttendeeStore::get(Handle handle) const {
+    return isCurrent(handle) ? AttendeeView(this, handle.index) : AttendeeView();
+}
+inline AttendeeView AttendeeStore::atSlot(size_t index) const {
+    return isLive(index) ? AttendeeView(this, index) : AttendeeView();
+}
+
+
+
+// ** InventoryItem Class **
+class InventoryItem {
+public:
+    int itemId;
+    string name;    // Change through setName() so nameKey stays in sync
+    string nameKey; // Lowercased name, computed once for name lookups
+    int totalQuantity;
+    int allocatedQuantity;
+    InternedString description; // Descriptions repeat across items ("Standard chairs")
+    static atomic<int> nextItemId;
+
+    InventoryItem(string n, int qty, InternedString desc);
+    InventoryItem(int id, string n, int totalQty, int allocQty, InternedString desc);
+    int getAvailableQuantity() const;
+    bool allocate(int quantityToAllocate);
+    bool deallocate(int quantityToDeallocate);
+    bool setTotalQuantity(int newTotalQuantity);
+    void setName(string newName);
+    void displayDetails() const;
+    string toString() const;
+    static InventoryItem fromString(string_view str);
+    static void initNextId(int id) { raiseNextId(nextItemId, id); }
+};
+atomic<int> InventoryItem::nextItemId{1};
+
+
+
+// ** Event Class **
+// The fields listings and status/date scans read stay in the record itself, which the events
+// SlotMap packs 256 to a page. The rest lives out of line in EventDetails, reached only by
+// detail views, exports, text searches and registration or inventory changes.
+// location and category repeat across events, so they are interned.
+struct EventDetails {
+    InternedString location;
+    string description;
+    InternedString category;
+    AttendeeSet attendeeIds;
+    FlatMap<int, int> allocatedInventory; // Item id -> quantity; most events allocate a few items
+    string storedDate; // Text of a loaded date that did not parse, saved back unchanged
+    string storedTime; // Likewise for the time
+};
+
+class Event {
+public:
+    int eventId;
+    PackedDate date;
+    PackedTime time;
+    EventStatus status;
+    string name;
+    unique_ptr<EventDetails> details; // Never null, except in a moved-from Event
+    static atomic<int> nextEventId;
+
+    Event(string n, PackedDate d, PackedTime t, InternedString loc, string desc, InternedString cat);
+    Event(int id, string n, PackedDate d, PackedTime t, InternedString loc,
+           string desc, InternedString cat, EventStatus stat);
+    Event(const Event& other);
+    Event(Event&& other) = default;
+    Event& operator=(const Event& other);
+    Event& operator=(Event&& other) = default;
+    void addAttendee(int attendeeId);
+    void removeAttendee(int attendeeId);
+    void allocateInventoryItem(int itemId, int quantity);
+    int deallocateInventoryItem(int itemId, int quantityToDeallocate);
+    string getStatusString() const;
+    string dateText() const; // YYYY-MM-DD, or the stored text if the loaded date did not parse
+    string timeText() const; // HH:MM, or the stored text if the loaded time did not parse
+    void displayDetails(const System& sys) const; // Definition after System
+    string attendeesToString() const;
+    string inventoryToString() const;
+    string headerToString() const; // Scalar fields only, without attendee/inventory lists
+    string toString() const;
+    static Event fromString(string_view str);
+    static void initNextId(int id) { raiseNextId(nextEventId, id); }
+};
+atomic<int> Event::nextEventId{1};
+
+
+
+// --- Strategy Pattern: Exporting Data ---
+// Moves a fully written temporary file over filename, so a failed save never leaves a torn data file
+bool replaceFile(const string& tempFile, const string& filename) {
+#ifdef _WIN32
+    // rename() does not replace existing files on Windows
+    if (!MoveFileExA(tempFile.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+#else
+    // rename() replaces the target atomically, so the old or new file always exists
+    if (rename(tempFile.c_str(), filename.c_str()) != 0) {
+#endif
+        cerr << "Error: Could not replace " << filename << ".\n";
+        return false;
+    }
+    return true;
+}
+
+// Abstract base class for export strategies; an export returns false if the file was not written
+class IExportStrategy {
+public:
+    virtual ~IExportStrategy() = default;
+    virtual bool exportUsers(const vector<User*>& users, const string& filename) const = 0;
+    virtual bool exportEvents(const SlotMap<Event>& events, const string& filename, const System& sys) const = 0;
+    virtual bool exportAttendees(const AttendeeStore& attendees, const string& filename) const = 0;
+    virtual bool exportInventory(const SlotMap<InventoryItem>& inventory, const string& filename) const = 0;
+};
+
+
+
+// Concrete strategy for text file export
+class TextExportStrategy : public IExportStrategy {
+public:
+    bool exportUsers(const vector<User*>& users, const string& filename) const override {
+        string tempFile = filename + ".tmp";
+        ofstream outFile(tempFile);
+        if (!outFile) {
+            cerr << "Error: Could not open " << tempFile << " for writing.\n";
+            return false;
+        }
+        for (const auto* user : users) {
+            if (user) {
+                outFile << user->toString() << endl;
+            }
+        }
+        outFile.close();
+        if (!outFile) {
+            cerr << "Error: Could not write " << tempFile << ".\n";
+            remove(tempFile.c_str());
+            return false;
+        }
+        if (!replaceFile(tempFile, filename)) return false;
+        cout << "Users data exported to " << filename << endl;
+        return true;
+    }
+
+    bool exportEvents(const SlotMap<Event>& events, const string& filename, const System& sys) const override {
+        string tempFile = filename + ".tmp";
+        ofstream outFile(tempFile);
+        if (!outFile) {
+            cerr << "Error: Could not open " << tempFile << " for writing.\n";
+            return false;
+        }
+        for (const auto& event : events) {
+            outFile << event.toString() << endl;
+        }
+        outFile.close();
+        if (!outFile) {
+            cerr << "Error: Could not write " << tempFile << ".\n";
+            remove(tempFile.c_str());
+            return false;
+        }
+        if (!replaceFile(tempFile, filename)) return false;
+        cout << "Events data exported to " << filename << endl;
+        return true;
+    }
+
+    bool exportAttendees(const AttendeeStore& attendees, const string& filename) const override {
+        string tempFile = filename + ".tmp";
+        ofstream outFile(tempFile);
+        if (!outFile) {
+            cerr << "Error: Could not open " << tempFile << " for writing.\n";
+            return false;
+        }
+        for (const auto& attendee : attendees) {
+            outFile << attendee.toString() << endl;
+        }
+        outFile.close();
+        if (!outFile) {
+            cerr << "Error: Could not write " << tempFile << ".\n";
+            remove(tempFile.c_str());
+            return false;
+        }
+        if (!replaceFile(tempFile, filename)) return false;
+        cout << "Attendees data exported to " << filename << endl;
+        return true;
+    }
+
+    bool exportInventory(const SlotMap<InventoryItem>& inventory, const string& filename) const override {
+        string tempFile = filename + ".tmp";
+        ofstream outFile(tempFile);
+        if (!outFile) {
+            cerr << "Error: Could not open " << tempFile << " for writing.\n";
+            return false;
+        }
+        for (const auto& item : inventory) {
+            outFile << item.toString() << endl;
+        }
+        outFile.close();
+        if (!outFile) {
+            cerr << "Error: Could not write " << tempFile << ".\n";
+            remove(tempFile.c_str());
+            return false;
+        }
+        if (!replaceFile(tempFile, filename)) return false;
+        cout << "Inventory data exported to " << filename << endl;
+        return true;
+    }
+};
+
+
+
+// --- Binary Snapshots ---
+// Each table is also saved as a binary snapshot next to its text file, so startup can map
+// the file and read records in place instead of parsing text. Layout (host byte order):
+//   header:  magic "EMSB", u32 version, u32 table, u32 record count, u64 payload size,
+//            u64 FNV-1a checksum of the payload (32 bytes in total)
+//   payload: records of int32 fields and strings stored as u32 length + bytes
+static_assert(sizeof(int) == 4, "Binary snapshots store int fields as 32-bit values");
+
+const uint32_t SNAPSHOT_VERSION = 5; // 2: attendees carry their owning user id; 3: packed event dates and times;
+                                     // 4: interned fields are dictionary encoded; 5: unparsed date/time text
+const size_t SNAPSHOT_HEADER_SIZE = 32;
+
+uint64_t snapshotChecksum(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+
+
+// Builds a snapshot payload in memory
+class SnapshotWriter {
+private:
+    string buffer;
+
+public:
+    void writeInt(int32_t value) { buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void writeUInt64(uint64_t value) { buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void writeString(string_view value) {
+        writeInt(static_cast<int32_t>(value.size()));
+        buffer.append(value.data(), value.size());
+    }
+    void writeIntArray(const vector<int>& values) {
+        writeInt(static_cast<int32_t>(values.size()));
+        if (!values.empty()) buffer.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+    }
+    void append(const SnapshotWriter& other) { buffer += other.buffer; }
+    const string& data() const { return buffer; }
+};
+
+// Dictionary encoding for the interned fields of one snapshot: each distinct value used is
+// written once, ahead of the records, and records store its position in that list
+class SnapshotDictionary {
+private:
+    vector<int32_t> positions; // Pool id -> position in this dictionary, -1 if not used yet
+    vector<uint32_t> poolIds;  // Position -> pool id
+
+public:
+    int32_t encode(const InternedString& value) {
+        uint32_t id = value.poolId();
+        if (id >= positions.size()) positions.resize(StringPool::shared().size(), -1);
+        if (positions[id] < 0) {
+            positions[id] = static_cast<int32_t>(poolIds.size());
+            poolIds.push_back(id);
+        }
+        return positions[id];
+    }
+    void writeTo(SnapshotWriter& out) const {
+        out.writeInt(static_cast<int32_t>(poolIds.size()));
+        for (uint32_t id : poolIds) out.writeString(StringPool::shared().lookup(id));
+    }
+};
+
+
+
+// Reads fields straight out of a mapped snapshot. Reads past the end set ok() to false
+// instead of throwing, so a damaged snapshot can be rejected after the fact.
+class SnapshotReader {
+private:
+    const char* cur;
+    const char* end;
+    bool valid;
+
+public:
+    SnapshotReader(const char* data, size_t size) : cur(data), end(data + size), valid(true) {}
+
+    bool ok() const { return valid; }
+    bool atEnd() const { return cur == end; }
+
+    int32_t readInt() {
+        int32_t value = 0;
+        if (static_cast<size_t>(end - cur) < sizeof(value)) { valid = false; return 0; }
+        memcpy(&value, cur, sizeof(value));
+        cur += sizeof(value);
+        return value;
+    }
+    // The view points into the mapping and is only valid while the file stays mapped
+    string_view readString() {
+        int32_t length = readInt();
+        if (!valid || length < 0 || static_cast<size_t>(end - cur) < static_cast<size_t>(length)) { valid = false; return {}; }
+        string_view value(cur, static_cast<size_t>(length));
+        cur += length;
+        return value;
+    }
+    // Bulk-copies a stored int array
+    void readIntArray(vector<int>& out) {
+        int32_t count = readInt();
+        if (!valid || count < 0 || static_cast<size_t>(end - cur) / sizeof(int) < static_cast<size_t>(count)) { valid = false; return; }
+        out.resize(static_cast<size_t>(count));
+        if (count > 0) memcpy(out.data(), cur, static_cast<size_t>(count) * sizeof(int));
+        cur += static_cast<size_t>(count) * sizeof(int);
+    }
+    // Reads a SnapshotDictionary, interning each value
+    void readDictionary(vector<InternedString>& out) {
+        int32_t count = readInt();
+        if (!valid || count < 0) { valid = false; return; }
+        for (int32_t i = 0; i < count && valid; ++i) out.emplace_back(readString());
+    }
+    InternedString readInterned(const vector<InternedString>& dictionary) {
+        int32_t position = readInt();
+        if (!valid || position < 0 || static_cast<size_t>(position) >= dictionary.size()) { valid = false; return InternedString(); }
+        return dictionary[static_cast<size_t>(position)];
+    }
+};
+
+
+
+// Read-only memory mapping of a whole file (RAII)
+class MappedFile {
+private:
+    const char* mappedData;
+    size_t mappedSize;
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#endif
+
+public:
+    explicit MappedFile(const string& filename) : mappedData(nullptr), mappedSize(0) {
+#ifdef _WIN32
+        mappingHandle = nullptr;
+        fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) return;
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle) return;
+        const void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (!view) return;
+        mappedData = static_cast<const char*>(view);
+        mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                mappedData = static_cast<const char*>(view);
+                mappedSize = static_cast<size_t>(info.st_size);
+            }
+        }
+        close(fd); // The mapping stays valid after the descriptor is closed
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (mappedData) UnmapViewOfFile(mappedData);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+#else
+        if (mappedData) munmap(const_cast<char*>(mappedData), mappedSize);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return mappedData != nullptr; }
+    const char* data() const { return mappedData; }
+    size_t size() const { return mappedSize; }
+};
+
+
+
+// Validates a mapped snapshot's header; on success returns a reader over its payload
+bool openSnapshotPayload(const MappedFile& file, DataTable table, SnapshotReader& reader, uint32_t& recordCount) {
+    if (!file.isOpen() || file.size() < SNAPSHOT_HEADER_SIZE) return false;
+    const char* header = file.data();
+    uint32_t version, storedTable;
+    uint64_t payloadSize, checksum;
+    memcpy(&version, header + 4, sizeof(version));
+    memcpy(&storedTable, header + 8, sizeof(storedTable));
+    memcpy(&recordCount, header + 12, sizeof(recordCount));
+    memcpy(&payloadSize, header + 16, sizeof(payloadSize));
+    memcpy(&checksum, header + 24, sizeof(checksum));
+    if (memcmp(header, "EMSB", 4) != 0 || version != SNAPSHOT_VERSION ||
+        storedTable != static_cast<uint32_t>(table) || payloadSize != file.size() - SNAPSHOT_HEADER_SIZE) {
+        return false;
+    }
+    const char* payload = header + SNAPSHOT_HEADER_SIZE;
+    if (snapshotChecksum(payload, payloadSize) != checksum) return false;
+    reader = SnapshotReader(payload, payloadSize);
+    return true;
+}
+
+
+
+// Concrete strategy for binary snapshot export
+class BinaryExportStrategy : public IExportStrategy {
+private:
+    // Writes header + payload to a temporary file, then swaps it in so a crash never leaves a torn snapshot
+    static bool writeSnapshot(const string& filename, DataTable table, size_t recordCount, const SnapshotWriter& payload) {
+        SnapshotWriter header;
+        header.writeInt(0); // Placeholder for the magic
+        header.writeInt(static_cast<int32_t>(SNAPSHOT_VERSION));
+        header.writeInt(static_cast<int32_t>(table));
+        header.writeInt(static_cast<int32_t>(recordCount));
+        header.writeUInt64(payload.data().size());
+        header.writeUInt64(snapshotChecksum(payload.data().data(), payload.data().size()));
+        string headerBytes = header.data();
+        memcpy(&headerBytes[0], "EMSB", 4);
+
+        string tempFile = filename + ".tmp";
+        ofstream outFile(tempFile, ios::binary | ios::trunc);
+        if (!outFile) {
+            cerr << "Error: Could not open " << tempFile << " for writing.\n";
+            return false;
+        }
+        outFile.write(headerBytes.data(), static_cast<streamsize>(headerBytes.size()));
+        outFile.write(payload.data().data(), static_cast<streamsize>(payload.data().size()));
+        outFile.close();
+        if (!outFile) {
+            cerr << "Error: Could not write " << tempFile << ".\n";
+            remove(tempFile.c_str());
+            return false;
+        }
+        return replaceFile(tempFile, filename);
+    }
+
+public:
+    bool exportUsers(const vector<User*>& users, const string& filename) const override {
+        SnapshotWriter payload;
+        size_t count = 0;
+        for (const auto* user : users) {
+            if (!user) continue;
+            payload.writeInt(user->getUserId());
+            payload.writeInt(static_cast<int32_t>(user->getRole()));
+            payload.writeString(user->getUsername());
+            payload.writeString(user->getPassword());
+            ++count;
+        }
+        return writeSnapshot(filename, DataTable::USERS, count, payload);
+    }
+
+    bool exportEvents(const SlotMap<Event>& events, const string& filename, const System&) const override {
+        SnapshotDictionary dictionary;
+        SnapshotWriter records;
+        for (const auto& event : events) {
+            records.writeInt(event.eventId);
+            records.writeInt(static_cast<int32_t>(event.status));
+            records.writeString(event.name);
+            records.writeInt(event.date);
+            records.writeInt(event.time);
+            records.writeString(event.details->storedDate);
+            records.writeString(event.details->storedTime);
+            records.writeInt(dictionary.encode(event.details->location));
+            records.writeString(event.details->description);
+            records.writeInt(dictionary.encode(event.details->category));
+            records.writeIntArray(event.details->attendeeIds.toVector());
+            records.writeInt(static_cast<int32_t>(event.details->allocatedInventory.size()));
+            for (const auto& pair : event.details->allocatedInventory) {
+                records.writeInt(pair.first);
+                records.writeInt(pair.second);
+            }
+        }
+        SnapshotWriter payload;
+        dictionary.writeTo(payload);
+        payload.append(records);
+        return writeSnapshot(filename, DataTable::EVENTS, events.size(), payload);
+    }
+
+    bool exportAttendees(const AttendeeStore& attendees, const string& filename) const override {
+        SnapshotWriter payload;
+        for (const auto& attendee : attendees) {
+            payload.writeInt(attendee.attendeeId());
+            payload.writeInt(attendee.eventIdRegisteredFor());
+            payload.writeInt(attendee.isCheckedIn() ? 1 : 0);
+            payload.writeInt(attendee.userId());
+            payload.writeString(attendee.name());
+            payload.writeString(attendee.contactInfo());
+        }
+        return writeSnapshot(filename, DataTable::ATTENDEES, attendees.size(), payload);
+    }
+
+    bool exportInventory(const SlotMap<InventoryItem>& inventory, const string& filename) const override {
+        SnapshotDictionary dictionary;
+        SnapshotWriter records;
+        for (const auto& item : inventory) {
+            records.writeInt(item.itemId);
+            records.writeInt(item.totalQuantity);
+            records.writeInt(item.allocatedQuantity);
+            records.writeString(item.name);
+            records.writeInt(dictionary.encode(item.description));
+        }
+        SnapshotWriter payload;
+        dictionary.writeTo(payload);
+        payload.append(records);
+        return writeSnapshot(filename, DataTable::INVENTORY, inventory.size(), payload);
+    }
+};
+
+
+
+// --- Write-Ahead Journal ---
+// Append-only log of the changes made since the last full save. Mutating System
+// methods record one line per change and commit them together, instead of
+// rewriting whole data files; loadData() replays the log on top of the files.
+class Journal {
+private:
+    string filename;
+    vector<string> pending;  // Recorded but not yet written entries
+    size_t committedEntries; // Entries on disk since the last full save
+
+public:
+    explicit Journal(string fname) : filename(std::move(fname)), committedEntries(0) {}
+
+    void record(const string& entry) { pending.push_back(entry); }
+
+    // Group commit: append every pending entry with a single write, then sync it to disk
+    bool commit() {
+        if (pending.empty()) return true;
+        string batch;
+        for (const auto& entry : pending) {
+            batch += entry;
+            batch += '\n';
+        }
+        FILE* outFile = fopen(filename.c_str(), "ab");
+        if (!outFile) {
+            cerr << "Error: Could not open " << filename << " for appending.\n";
+            return false;
+        }
+        bool written = fwrite(batch.data(), 1, batch.size(), outFile) == batch.size() && fflush(outFile) == 0;
+#ifdef _WIN32
+        written = written && _commit(_fileno(outFile)) == 0;
+#else
+        written = written && fsync(fileno(outFile)) == 0;
+#endif
+        if (fclose(outFile) != 0) written = false;
+        if (!written) {
+            cerr << "Error: Could not write to " << filename << ".\n";
+            return false;
+        }
+        committedEntries += pending.size();
+        pending.clear();
+        return true;
+    }
+
+    // Reads all complete entries. A torn last line (no trailing newline) is ignored and cut
+    // from the file, so the next commit does not append onto the fragment.
+    vector<string> readEntries() {
+        vector<string> entries;
+        ifstream inFile(filename, ios::binary);
+        if (!inFile) return entries;
+        string contents((istreambuf_iterator<char>(inFile)), istreambuf_iterator<char>());
+        size_t start = 0, end;
+        while ((end = contents.find('\n', start)) != string::npos) {
+            if (end > start) entries.push_back(contents.substr(start, end - start));
+            start = end + 1;
+        }
+        inFile.close();
+        if (start < contents.size()) {
+            error_code ec;
+            filesystem::resize_file(filename, start, ec);
+            if (ec) cerr << "Warning: Could not drop the incomplete last entry of " << filename << ".\n";
+        }
+        committedEntries = entries.size();
+        return entries;
+    }
+
+    // Called once a full save has made the logged changes redundant
+    void clear() {
+        ofstream outFile(filename, ios::trunc | ios::binary);
+        committedEntries = 0;
+        pending.clear();
+    }
+
+    size_t size() const { return committedEntries; }
+    bool empty() const { return committedEntries == 0 && pending.empty(); }
+};
+
+
+
+// --- Inverted Text Index ---
+// Maps each word to a posting list of (document id, occurrences), sorted by id. Documents
+// are added and removed with the same token list, so updates touch only their own words.
+class InvertedIndex {
+private:
+    struct Posting {
+        int docId;
+        int termCount;
+    };
+    unordered_map<string, vector<Posting>> postings;
+    unordered_map<int, size_t> postingsPerDocument; // Documents with at least one posting; its size is N for idf
+
+public:
+
+    // Lowercased runs of letters and digits (bytes >= 128 count as letters, to keep UTF-8 words whole)
+    static vector<string> tokenize(string_view text) {
+        vector<string> tokens;
+        string current;
+        for (char ch : text) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (isalnum(c) || c >= 128) {
+                current += static_cast<char>(tolower(c));
+            } else if (!current.empty()) {
+                tokens.push_back(std::move(current));
+                current.clear();
+            }
+        }
+        if (!current.empty()) tokens.push_back(std::move(current));
+        return tokens;
+    }
+
+    void add(int docId, const vector<string>& tokens) {
+        map<string, int> counts;
+        for (const auto& token : tokens) counts[token]++;
+        for (const auto& entry : counts) {
+            vector<Posting>& list = postings[entry.first];
+            auto pos = lower_bound(list.begin(), list.end(), docId,
+                                   [](const Posting& p, int id) { return p.docId < id; });
+            if (pos != list.end() && pos->docId == docId) {
+                pos->termCount = entry.second;
+            } else {
+                list.insert(pos, Posting{ docId, entry.second }); // New ids are usually the largest: an append
+                postingsPerDocument[docId]++;
+            }
+        }
+    }
+
+    void remove(int docId, const vector<string>& tokens) {
+        for (const auto& token : tokens) {
+            auto found = postings.find(token);
+            if (found == postings.end()) continue;
+            vector<Posting>& list = found->second;
+            auto pos = lower_bound(list.begin(), list.end(), docId,
+                                   [](const Posting& p, int id) { return p.docId < id; });
+            if (pos != list.end() && pos->docId == docId) {
+                list.erase(pos);
+                if (list.empty()) postings.erase(found);
+                auto document = postingsPerDocument.find(docId);
+                if (document != postingsPerDocument.end() && --document->second == 0) postingsPerDocument.erase(document);
+            }
+        }
+    }
+
+    void clear() {
+        postings.clear();
+        postingsPerDocument.clear();
+    }
+
+    // Ranked search. matchAll requires every query word (AND), otherwise any word (OR).
+    // Scores are tf-idf sums; results are ordered best first, then by id.
+    vector<pair<int, double>> search(string_view query, bool matchAll) const {
+        vector<string> words = tokenize(query);
+        sort(words.begin(), words.end());
+        words.erase(unique(words.begin(), words.end()), words.end());
+
+        vector<const vector<Posting>*> lists;
+        for (const auto& word : words) {
+            auto found = postings.find(word);
+            if (found != postings.end()) {
+                lists.push_back(&found->second);
+            } else if (matchAll) {
+                return {}; // A missing word empties an AND query
+            }
+        }
+        if (lists.empty()) return {};
+
+        unordered_map<int, double> scores;
+        unordered_map<int, size_t> matchedWords;
+        for (const auto* list : lists) {
+            double idf = log(1.0 + static_cast<double>(postingsPerDocument.size()) / list->size());
+            for (const auto& posting : *list) {
+                scores[posting.docId] += posting.termCount * idf;
+                matchedWords[posting.docId]++;
+            }
+        }
+        vector<pair<int, double>> results;
+        for (const auto& entry : scores) {
+            if (!matchAll || matchedWords[entry.first] == lists.size()) results.push_back(entry);
+        }
+        sort(results.begin(), results.end(), [](const pair<int, double>& a, const pair<int, double>& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        return results;
+    }
+};
+
+
+
+// --- Trigram Index ---
+// Maps every three-character sequence of the lowercased fields to the sorted ids of the
+// documents containing it. Substring queries intersect the query's trigram lists and only
+// verify the surviving candidates; fuzzy queries rank documents by shared trigrams.
+class TrigramIndex {
+private:
+    unordered_map<uint32_t, vector<int>> postings;
+    unordered_map<int, vector<string>> documents; // Lowercased fields, kept for verification and removal
+
+    static uint32_t trigramKey(unsigned char a, unsigned char b, unsigned char c) {
+        return (static_cast<uint32_t>(a) << 16) | (static_cast<uint32_t>(b) << 8) | c;
+    }
+    // Distinct trigrams of the text; padded texts get a leading and trailing space,
+    // so word starts and ends produce their own trigrams
+    static vector<uint32_t> trigramsOf(const string& lowered, bool padded) {
+        string text = padded ? " " + lowered + " " : lowered;
+        vector<uint32_t> keys;
+        for (size_t i = 0; i + 2 < text.size(); ++i) {
+            keys.push_back(trigramKey(text[i], text[i + 1], text[i + 2]));
+        }
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+    }
+    static vector<uint32_t> trigramsOfDocument(const vector<string>& fields) {
+        vector<uint32_t> keys;
+        for (const auto& field : fields) {
+            vector<uint32_t> more = trigramsOf(field, true);
+            keys.insert(keys.end(), more.begin(), more.end());
+        }
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+    }
+    static string lowered(string_view text) {
+        string result(text);
+        for (char& c : result) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        return result;
+    }
+
+public:
+    void add(int docId, const vector<string>& fields) {
+        vector<string> stored;
+        for (const auto& field : fields) stored.push_back(lowered(field));
+        for (uint32_t key : trigramsOfDocument(stored)) {
+            vector<int>& list = postings[key];
+            list.insert(upper_bound(list.begin(), list.end(), docId), docId);
+        }
+        documents[docId] = std::move(stored);
+    }
+
+    void remove(int docId) {
+        auto doc = documents.find(docId);
+        if (doc == documents.end()) return;
+        for (uint32_t key : trigramsOfDocument(doc->second)) {
+            auto found = postings.find(key);
+            if (found == postings.end()) continue;
+            vector<int>& list = found->second;
+            auto pos = lower_bound(list.begin(), list.end(), docId);
+            if (pos != list.end() && *pos == docId) list.erase(pos);
+            if (list.empty()) postings.erase(found);
+        }
+        documents.erase(doc);
+    }
+
+    void clear() {
+        postings.clear();
+        documents.clear();
+    }
+
+    // Upper bound on findSubstring's candidates: the shortest posting list among the query's trigrams
+    size_t substringCandidateBound(string_view query) const {
+        string needle = lowered(query);
+        if (needle.size() < 3) return documents.size();
+        size_t bound = documents.size();
+        for (uint32_t key : trigramsOf(needle, false)) {
+            auto found = postings.find(key);
+            if (found == postings.end()) return 0;
+            bound = min(bound, found->second.size());
+        }
+        return bound;
+    }
+
+    // Ids of documents with a field containing the query (case-insensitive), in id order
+    vector<int> findSubstring(string_view query) const {
+        string needle = lowered(query);
+        vector<int> candidates;
+        if (needle.size() < 3) {
+            // Too short to have a trigram: check the stored lowercased fields directly
+            for (const auto& doc : documents) candidates.push_back(doc.first);
+            sort(candidates.begin(), candidates.end());
+        } else {
+            vector<const vector<int>*> lists;
+            for (uint32_t key : trigramsOf(needle, false)) {
+                auto found = postings.find(key);
+                if (found == postings.end()) return {};
+                lists.push_back(&found->second);
+            }
+            sort(lists.begin(), lists.end(), [](const vector<int>* a, const vector<int>* b) { return a->size() < b->size(); });
+            candidates = *lists.front();
+            for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+                vector<int> narrowed;
+                set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(), back_inserter(narrowed));
+                candidates.swap(narrowed);
+            }
+        }
+        vector<int> matches;
+        for (int docId : candidates) {
+            for (const auto& field : documents.at(docId)) {
+                if (field.find(needle) != string::npos) { matches.push_back(docId); break; }
+            }
+        }
+        return matches;
+    }
 
-// ** RegularUser Class ** Inheritance from User
-class RegularUser : public User {
-public:
-    RegularUser(string uname, string pwd);
-    RegularUser(int id, string uname, string pwd);
-    void displayMenu(System& sys) override;
-    void displayDetails() const override; // Implementation for RegularUser
+    // Documents sharing at least minSimilarity of the query's trigrams, best first, then by id
+    vector<pair<int, double>> findSimilar(string_view query, double minSimilarity) const {
+        vector<uint32_t> keys = trigramsOf(lowered(query), true);
+        if (keys.empty()) return {};
+        unordered_map<int, int> shared;
+        for (uint32_t key : keys) {
+            auto found = postings.find(key);
+            if (found == postings.end()) continue;
+            for (int docId : found->second) shared[docId]++;
+        }
+        vector<pair<int, double>> results;
+        for (const auto& entry : shared) {
+            double similarity = static_cast<double>(entry.second) / keys.size();
+            if (similarity >= minSimilarity) results.emplace_back(entry.first, similarity);
+        }
+        sort(results.begin(), results.end(), [](const pair<int, double>& a, const pair<int, double>& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        return results;
+    }
 };
 
 
 
-// ** Attendee Class **
-class Attendee {
+// --- Name Completion Trie ---
+// Case-insensitive prefix tree of names with the id each name belongs to. Children are
+// kept in a sorted vector, so a lookup costs one short binary search per prefix character,
+// and each node knows how far below it the shortest name ends, so completion can go
+// best-first to the k shortest names without walking the rest of the subtree.
+class NameTrie {
 public:
-    int attendeeId;
-    string name;
-    string contactInfo;
-    int eventIdRegisteredFor;
-    bool isCheckedIn;
-    static int nextAttendeeId;
+    struct Completion {
+        string name;
+        int id;
+    };
 
-    Attendee(string n, string contact, int eventId);
-    Attendee(int id, string n, string contact, int eventId, bool checkedInStatus);
-    void checkIn();
-    void displayDetails() const;
-    string toString() const;
-    static Attendee fromString(const string& str);
-    static void initNextId(int id) { if (id >= nextAttendeeId) nextAttendeeId = id + 1;}
-};
-int Attendee::nextAttendeeId = 1;
+private:
+    struct Node {
+        vector<pair<char, unique_ptr<Node>>> children; // Sorted by character
+        vector<Completion> entries;                    // Names ending at this node
+        size_t shortestBelow = NO_NAMES;               // Characters to the nearest name in this subtree
+    };
+    static constexpr size_t NO_NAMES = numeric_limits<size_t>::max();
+    Node root;
+
+    static void refreshShortest(Node& node) {
+        node.shortestBelow = node.entries.empty() ? NO_NAMES : 0;
+        for (const auto& next : node.children) {
+            if (next.second->shortestBelow != NO_NAMES) node.shortestBelow = min(node.shortestBelow, next.second->shortestBelow + 1);
+        }
+    }
 
+    static char fold(char c) { return static_cast<char>(tolower(static_cast<unsigned char>(c))); }
 
+    static Node* child(const Node& node, char c) {
+        auto it = lower_bound(node.children.begin(), node.children.end(), c,
+                              [](const pair<char, unique_ptr<Node>>& entry, char key) { return entry.first < key; });
+        return (it != node.children.end() && it->first == c) ? it->second.get() : nullptr;
+    }
+    const Node* find(string_view key) const {
+        const Node* node = &root;
+        for (char c : key) {
+            node = child(*node, fold(c));
+            if (!node) return nullptr;
+        }
+        return node;
+    }
+    // Best-first over disjoint subtrees keyed by (shortest name length, folded path). No
+    // subtree's path is a prefix of another's, so the path orders all of their names, and
+    // a subtree is only expanded once it holds the next shortest, alphabetically first name.
+    struct Frontier {
+        size_t length; // Of the shortest name below node, counted from the completion start
+        string label;  // Folded characters from the completion start to node
+        const Node* node;
+        bool operator>(const Frontier& other) const {
+            return length != other.length ? length > other.length : label > other.label;
+        }
+    };
+    static void collect(const Node& start, size_t limit, vector<Completion>& out) {
+        if (start.shortestBelow == NO_NAMES) return;
+        priority_queue<Frontier, vector<Frontier>, greater<Frontier>> frontier;
+        frontier.push(Frontier{ start.shortestBelow, string(), &start });
+        while (!frontier.empty()) {
+            Frontier best = frontier.top();
+            frontier.pop();
+            for (const auto& entry : best.node->entries) {
+                if (out.size() >= limit) return;
+                out.push_back(entry);
+            }
+            for (const auto& next : best.node->children) {
+                if (next.second->shortestBelow == NO_NAMES) continue;
+                frontier.push(Frontier{ best.label.size() + 1 + next.second->shortestBelow, best.label + next.first, next.second.get() });
+            }
+        }
+    }
+    // Returns true when the node is left empty and can be pruned by its parent
+    static bool removeFrom(Node& node, string_view key, const string& name, int id) {
+        if (key.empty()) {
+            auto it = find_if(node.entries.begin(), node.entries.end(),
+                              [&](const Completion& entry) { return entry.id == id && entry.name == name; });
+            if (it != node.entries.end()) node.entries.erase(it);
+        } else {
+            char c = fold(key.front());
+            auto it = lower_bound(node.children.begin(), node.children.end(), c,
+                                  [](const pair<char, unique_ptr<Node>>& entry, char k) { return entry.first < k; });
+            if (it == node.children.end() || it->first != c) return false;
+            if (removeFrom(*it->second, key.substr(1), name, id)) node.children.erase(it);
+        }
+        refreshShortest(node);
+        return node.entries.empty() && node.children.empty();
+    }
 
-// ** InventoryItem Class **
-class InventoryItem {
 public:
-    int itemId;
-    string name;
-    int totalQuantity;
-    int allocatedQuantity;
-    string description;
-    static int nextItemId;
-
-    InventoryItem(string n, int qty, string desc);
-    InventoryItem(int id, string n, int totalQty, int allocQty, string desc);
-    int getAvailableQuantity() const;
-    bool allocate(int quantityToAllocate);
-    bool deallocate(int quantityToDeallocate);
-    void setTotalQuantity(int newTotalQuantity);
-    void displayDetails() const;
-    string toString() const;
-    static InventoryItem fromString(const string& str);
-    static void initNextId(int id) { if (id >= nextItemId) nextItemId = id + 1;}
-};
-int InventoryItem::nextItemId = 1;
+    void insert(const string& name, int id) {
+        Node* node = &root;
+        root.shortestBelow = min(root.shortestBelow, name.size());
+        for (size_t i = 0; i < name.size(); ++i) {
+            char c = fold(name[i]);
+            auto it = lower_bound(node->children.begin(), node->children.end(), c,
+                                  [](const pair<char, unique_ptr<Node>>& entry, char key) { return entry.first < key; });
+            if (it == node->children.end() || it->first != c) {
+                it = node->children.emplace(it, c, make_unique<Node>());
+            }
+            node = it->second.get();
+            node->shortestBelow = min(node->shortestBelow, name.size() - i - 1);
+        }
+        node->entries.push_back(Completion{ name, id });
+    }
 
+    void remove(const string& name, int id) {
+        removeFrom(root, name, name, id);
+    }
 
+    void clear() {
+        root.children.clear();
+        root.entries.clear();
+        root.shortestBelow = NO_NAMES;
+    }
 
-// ** Event Class **
-class Event {
-public:
-    int eventId;
-    string name;
-    string date;
-    string time;
-    string location;
-    string description;
-    string category;
-    EventStatus status;
-    vector<int> attendeeIds;
-    map<int, int> allocatedInventory;
-    static int nextEventId;
+    // Up to limit names starting with prefix (case-insensitive), shortest and alphabetical first
+    vector<Completion> complete(string_view prefix, size_t limit) const {
+        vector<Completion> out;
+        const Node* node = find(prefix);
+        if (node && limit > 0) collect(*node, limit, out);
+        return out;
+    }
 
-    Event(string n, string d, string t, string loc, string desc, string cat);
-    Event(int id, string n, string d, string t, string loc,
-           string desc, string cat, EventStatus stat);
-    void addAttendee(int attendeeId);
-    void removeAttendee(int attendeeId);
-    void allocateInventoryItem(int itemId, int quantity);
-    int deallocateInventoryItem(int itemId, int quantityToDeallocate);
-    string getStatusString() const;
-    void displayDetails(const System& sys) const; // Definition after System
-    string attendeesToString() const;
-    string inventoryToString() const;
-    string toString() const;
-    static Event fromString(const string& str);
-    static void initNextId(int id) { if (id >= nextEventId) nextEventId = id + 1;}
+    // Entries whose whole name equals the key (case-insensitive)
+    vector<Completion> lookup(string_view name) const {
+        const Node* node = find(name);
+        return node ? node->entries : vector<Completion>();
+    }
 };
-int Event::nextEventId = 1;
 
 
 
-// --- Strategy Pattern: Exporting Data ---
-// Abstract base class for export strategies
-class IExportStrategy {
-public:
-    virtual ~IExportStrategy() = default;
-    virtual void exportUsers(const vector<User*>& users, const string& filename) const = 0;
-    virtual void exportEvents(const vector<Event>& events, const string& filename, const System& sys) const = 0;
-    virtual void exportAttendees(const vector<Attendee>& attendees, const string& filename) const = 0;
-    virtual void exportInventory(const vector<InventoryItem>& inventory, const string& filename) const = 0;
-};
+// --- Query Engine ---
+// Fields a query can test. Text fields compare ASCII case-insensitively; the rest are numbers:
+// dates as days since 1900-01-01, statuses as their EventStatus value and check-in as 0 or 1.
+enum class QueryField { ID, NAME, LOCATION, CATEGORY, DESCRIPTION, STATUS, DATE, ATTENDEE_COUNT, CONTACT, EVENT_ID, CHECKED_IN };
 
+bool isTextField(QueryField field) {
+    return field == QueryField::NAME || field == QueryField::LOCATION || field == QueryField::CATEGORY ||
+           field == QueryField::DESCRIPTION || field == QueryField::CONTACT;
+}
 
+string_view queryText(const Event& event, QueryField field) {
+    switch (field) {
+        case QueryField::NAME: return event.name;
+        case QueryField::LOCATION: return event.details->location.str();
+        case QueryField::CATEGORY: return event.details->category.str();
+        case QueryField::DESCRIPTION: return event.details->description;
+        default: return string_view();
+    }
+}
+long long queryNumber(const Event& event, QueryField field) {
+    switch (field) {
+        case QueryField::ID: return event.eventId;
+        case QueryField::STATUS: return static_cast<int>(event.status);
+        case QueryField::DATE: return event.date;
+        case QueryField::ATTENDEE_COUNT: return static_cast<long long>(event.details->attendeeIds.size());
+        default: return -1;
+    }
+}
+string_view queryText(const AttendeeView& att, QueryField field) {
+    switch (field) {
+        case QueryField::NAME: return att.name();
+        case QueryField::CONTACT: return att.contactInfo();
+        default: return string_view();
+    }
+}
+long long queryNumber(const AttendeeView& att, QueryField field) {
+    switch (field) {
+        case QueryField::ID: return att.attendeeId();
+        case QueryField::EVENT_ID: return att.eventIdRegisteredFor();
+        case QueryField::CHECKED_IN: return att.isCheckedIn() ? 1 : 0;
+        default: return -1;
+    }
+}
 
-// Concrete strategy for text file export
-class TextExportStrategy : public IExportStrategy {
+// A predicate tree over Event or Attendee fields. Leaves test one field; ALL_OF, ANY_OF and
+// NOT combine other predicates. Text operands are lowercased once, when the leaf is built.
+class QueryPredicate {
 public:
-    void exportUsers(const vector<User*>& users, const string& filename) const override {
-        ofstream outFile(filename);
-        if (!outFile) {
-            cerr << "Error: Could not open " << filename << " for writing.\n";
-            return;
-        }
-        for (const auto* user : users) {
-            if (user) {
-                outFile << user->toString() << endl;
+    enum class Kind { CONTAINS, EQUALS, BETWEEN, ALL_OF, ANY_OF, NOT };
+    Kind kind;
+    QueryField field;
+    string text;
+    long long low;
+    long long high;
+    vector<QueryPredicate> children;
+
+    static QueryPredicate contains(QueryField field, const string& text) { return leaf(Kind::CONTAINS, field, toLower(text), 0, 0); }
+    static QueryPredicate equals(QueryField field, const string& text) { return leaf(Kind::EQUALS, field, toLower(text), 0, 0); }
+    static QueryPredicate equals(QueryField field, long long value) { return leaf(Kind::BETWEEN, field, "", value, value); }
+    static QueryPredicate between(QueryField field, long long low, long long high) { return leaf(Kind::BETWEEN, field, "", low, high); }
+    static QueryPredicate allOf(vector<QueryPredicate> parts) { return group(Kind::ALL_OF, std::move(parts)); }
+    static QueryPredicate anyOf(vector<QueryPredicate> parts) { return group(Kind::ANY_OF, std::move(parts)); }
+    static QueryPredicate negate(QueryPredicate part) { return group(Kind::NOT, { std::move(part) }); }
+
+    template <typename Record>
+    bool matches(const Record& record) const {
+        switch (kind) {
+            case Kind::CONTAINS: return containsIgnoreCase(queryText(record, field), text);
+            case Kind::EQUALS: {
+                string_view value = queryText(record, field);
+                return value.size() == text.size() && equalsIgnoreCaseAscii(value.data(), text.data(), text.size());
+            }
+            case Kind::BETWEEN: {
+                long long value = queryNumber(record, field);
+                return value >= low && value <= high;
             }
+            case Kind::ALL_OF:
+                for (const auto& child : children) if (!child.matches(record)) return false;
+                return true;
+            case Kind::ANY_OF:
+                for (const auto& child : children) if (child.matches(record)) return true;
+                return false;
+            case Kind::NOT: return !children.front().matches(record);
         }
-        outFile.close();
-        cout << "Users data exported to " << filename << endl;
+        return false;
     }
 
-    void exportEvents(const vector<Event>& events, const string& filename, const System& sys) const override {
-        ofstream outFile(filename);
-        if (!outFile) {
-            cerr << "Error: Could not open " << filename << " for writing.\n";
-            return;
-        }
-        for (const auto& event : events) {
-            outFile << event.toString() << endl;
+    // The leaves every match must satisfy (this leaf, or the leaves of a top-level ALL_OF);
+    // these are the ones an index can narrow the candidates with
+    vector<const QueryPredicate*> requiredLeaves() const {
+        vector<const QueryPredicate*> leaves;
+        if (kind == Kind::ALL_OF) {
+            for (const auto& child : children) {
+                if (child.kind != Kind::ALL_OF && child.kind != Kind::ANY_OF && child.kind != Kind::NOT) leaves.push_back(&child);
+            }
+        } else if (kind != Kind::ANY_OF && kind != Kind::NOT) {
+            leaves.push_back(this);
         }
-        outFile.close();
-        cout << "Events data exported to " << filename << endl;
+        return leaves;
     }
 
-    void exportAttendees(const vector<Attendee>& attendees, const string& filename) const override {
-        ofstream outFile(filename);
-        if (!outFile) {
-            cerr << "Error: Could not open " << filename << " for writing.\n";
-            return;
-        }
-        for (const auto& attendee : attendees) {
-            outFile << attendee.toString() << endl;
-        }
-        outFile.close();
-        cout << "Attendees data exported to " << filename << endl;
+private:
+    static QueryPredicate leaf(Kind kind, QueryField field, string text, long long low, long long high) {
+        return QueryPredicate{ kind, field, std::move(text), low, high, {} };
     }
+    static QueryPredicate group(Kind kind, vector<QueryPredicate> parts) {
+        return QueryPredicate{ kind, QueryField::ID, "", 0, 0, std::move(parts) };
+    }
+};
 
-    void exportInventory(const vector<InventoryItem>& inventory, const string& filename) const override {
-        ofstream outFile(filename);
-        if (!outFile) {
-            cerr << "Error: Could not open " << filename << " for writing.\n";
-            return;
-        }
-        for (const auto& item : inventory) {
-            outFile << item.toString() << endl;
+// Result ordering and size for a query; limit 0 means no limit
+struct QueryOptions {
+    QueryField orderBy = QueryField::ID;
+    bool descending = false;
+    size_t limit = 0;
+};
+
+// Sorts matched records by the requested field (ties by id) and applies the limit
+template <typename Row>
+void orderQueryResults(vector<Row>& rows, const QueryOptions& options) {
+    auto less = [&](const Row& a, const Row& b) {
+        if (isTextField(options.orderBy)) {
+            string_view x = queryText(recordOf(a), options.orderBy), y = queryText(recordOf(b), options.orderBy);
+            int order = 0;
+            for (size_t i = 0; i < min(x.size(), y.size()) && order == 0; ++i) {
+                int cx = tolower(static_cast<unsigned char>(x[i])), cy = tolower(static_cast<unsigned char>(y[i]));
+                order = cx - cy;
+            }
+            if (order == 0) order = static_cast<int>(x.size()) - static_cast<int>(y.size());
+            if (order != 0) return options.descending ? order > 0 : order < 0;
+        } else {
+            long long x = queryNumber(recordOf(a), options.orderBy), y = queryNumber(recordOf(b), options.orderBy);
+            if (x != y) return options.descending ? x > y : x < y;
         }
-        outFile.close();
-        cout << "Inventory data exported to " << filename << endl;
+        return queryNumber(recordOf(a), QueryField::ID) < queryNumber(recordOf(b), QueryField::ID);
+    };
+    if (options.limit > 0 && options.limit < rows.size()) {
+        partial_sort(rows.begin(), rows.begin() + options.limit, rows.end(), less);
+        rows.resize(options.limit);
+    } else {
+        sort(rows.begin(), rows.end(), less);
     }
-};
+}
 
 
 
@@ -365,13 +2792,15 @@ private:
     static System* instance;
 
     // Private constructor for Singleton
-    System() : currentUser(nullptr), exportStrategy(new TextExportStrategy()) {}
+    System() : currentUser(nullptr), exportStrategy(new TextExportStrategy()),
+               snapshotStrategy(new BinaryExportStrategy()), journal(JOURNAL_FILE) {}
 
     // Delete copy constructor and assignment operator to prevent copying
     System(const System&) = delete;
     System& operator=(const System&) = delete;
 
     IExportStrategy* exportStrategy; // Member for the chosen export strategy
+    IExportStrategy* snapshotStrategy; // Binary snapshots written alongside the text files
 
 public:
     // Public static method to get the single instance of System
@@ -393,28 +2822,110 @@ public:
 
     // Data members
     vector<User*> users; //Polymorphism
-    vector<Event> events;
-    vector<InventoryItem> inventory;
-    vector<Attendee> allAttendees;
+    SlotMap<Event> events;
+    SlotMap<InventoryItem> inventory;
+    AttendeeStore allAttendees; // Columnar; records are reached through views
     User* currentUser;
 
+    // Id -> slot map handle indexes over events, allAttendees and inventory. The insert and
+    // erase helpers keep them current; loads rebuild them. Records never move, so a handle
+    // (or a pointer or view from a find function) stays valid until that record is erased.
+    unordered_map<int, SlotMap<Event>::Handle> eventSlots;
+    unordered_map<int, AttendeeStore::Handle> attendeeSlots;
+    unordered_map<int, SlotMap<InventoryItem>::Handle> inventorySlots;
+    unordered_map<string, SlotMap<InventoryItem>::Handle, CaseInsensitiveHash, CaseInsensitiveEqual> inventoryNameSlots; // nameKey -> item
+    Event& insertEvent(Event event);
+    AttendeeRef insertAttendee(const Attendee& attendee);
+    InventoryItem& insertInventoryItem(InventoryItem item);
+    void eraseEventRecord(int eventId);       // Callers remove the event from the search indexes first
+    void eraseAttendeeRecord(int attendeeId);
+    void eraseAttendeesOfEvent(int eventId);  // O(registrations), driven by registrationsByEvent
+    static constexpr size_t COMPACTION_MIN_TOMBSTONES = 1024;
+    template <typename Records> static void compactIfWorthwhile(Records& records);
+    void compactStorage(); // Reclaims every tombstoned slot; run after saves
+    void rebuildEventIndex();
+    void rebuildAttendeeIndex();
+    void rebuildInventoryIndex();
+    void renameInventoryItem(InventoryItem& item, const string& newName);
+
+    // Name completion for events, inventory items and usernames, kept current by the
+    // index helpers above and below
+    NameTrie eventNames;
+    NameTrie inventoryNames;
+    NameTrie usernames;
+    static constexpr size_t COMPLETION_LIMIT = 10;
+    int getIdInputWithCompletion(const string& prompt, const NameTrie& names) const;
+
+    // Secondary event indexes (keyed by event id, so unaffected by position shifts). Callers
+    // remove an event before changing indexed fields or erasing it, and add it back after.
+    set<pair<long long, int>> eventsByStart; // (eventStartKey, eventId), ordered by start
+    InvertedIndex eventText; // Words of name, description, location and category
+    static vector<string> eventTextTokens(const Event& event);
+    TrigramIndex eventTrigrams; // Name, location and date, for substring and typo-tolerant search
+    static constexpr double FUZZY_MATCH_THRESHOLD = 0.45;
+    RoaringBitmap eventsByStatus[EVENT_STATUS_COUNT]; // Event ids per EventStatus value
+    unordered_map<string, RoaringBitmap, CaseInsensitiveHash, CaseInsensitiveEqual> eventsByCategory;
+    void addToEventIndexes(const Event& event);
+    void removeFromEventIndexes(const Event& event);
+    void rebuildEventSearchIndexes();
+
+    // User id and event id -> ids of the attendee records they own, rebuilt with attendeeSlots.
+    // Built from the records themselves, so they hold even when an event's attendeeIds disagree.
+    unordered_map<int, vector<int>> registrationsByUser;
+    unordered_map<int, AttendeeSet> registrationsByEvent; // O(log n) removal for single cancels
+    void indexRegistration(int attendeeId, int eventId, int userId);
+    void unindexRegistration(int attendeeId, int eventId, int userId);
+    vector<AttendeeRef> findRegistrationsOfUser(int userId);
+    void resolveAttendeeOwners(); // Assigns user ids to records from older files by name
+
+    // Username -> user index for login and username lookups
+    unordered_map<string, User*> usersByName;
+    void indexUser(User* user);
+    void unindexUser(const User* user);
+    void rebuildUserIndex();
+
     // File names
     const string USERS_FILE = "users.txt";
     const string EVENTS_FILE = "events.txt";
     const string INVENTORY_FILE = "inventory.txt";
     const string ATTENDEES_FILE = "attendees.txt";
+    const string JOURNAL_FILE = "journal.txt";
+    const string USERS_SNAPSHOT = "users.bin";
+    const string EVENTS_SNAPSHOT = "events.bin";
+    const string INVENTORY_SNAPSHOT = "inventory.bin";
+    const string ATTENDEES_SNAPSHOT = "attendees.bin";
+
+    // Journal of changes since the last full save (see Journal)
+    Journal journal;
+    const size_t JOURNAL_CHECKPOINT_ENTRIES = 5000; // Full save once the journal grows past this
+
+    // Tables changed since their file was last written, indexed by DataTable
+    bool dirtyTables[4] = { false, false, false, false };
 
     // Data loading and saving methods (now use export strategy internally for saving)
     void loadData();
-    void saveData(); // Calls individual save methods which use the strategy
-    void loadUsers();
-    void saveUsers(); // Uses exportStrategy
+    void saveData(); // Saves only the dirty tables through the strategy, then clears the journal if all succeeded
+    void markDirty(DataTable table) { dirtyTables[static_cast<int>(table)] = true; }
+    bool isDirty(DataTable table) const { return dirtyTables[static_cast<int>(table)]; }
+    void recordChange(const string& entry); // Journals a change and marks the tables it touches
+    void markDirtyForJournalEntry(const string& entry);
+    void commitJournal(); // Group-commits recorded changes, saving in full when the journal is long
+    void replayJournal();
+    void applyJournalEntry(const string& entry);
+    void loadUsers(); // Prefers the binary snapshot; a text fallback marks the table dirty so the snapshot is rewritten
+    bool saveUsers(); // Uses exportStrategy and snapshotStrategy; false if a file was not written
     void loadEvents();
-    void saveEvents(); // Uses exportStrategy
+    bool saveEvents(); // Uses exportStrategy and snapshotStrategy; false if a file was not written
     void loadInventory();
-    void saveInventory(); // Uses exportStrategy
+    bool saveInventory(); // Uses exportStrategy and snapshotStrategy; false if a file was not written
     void loadAttendees();
-    void saveAttendees(); // Uses exportStrategy
+    bool saveAttendees(); // Uses exportStrategy and snapshotStrategy; false if a file was not written
+    bool openSnapshot(const MappedFile& file, const string& snapshotFile, const string& textFile,
+                      DataTable table, SnapshotReader& reader, uint32_t& recordCount) const;
+    bool loadUsersSnapshot();
+    bool loadEventsSnapshot();
+    bool loadInventorySnapshot();
+    bool loadAttendeesSnapshot();
 
     // User management
     bool usernameExists(const string& uname) const;
@@ -425,6 +2936,15 @@ public:
     const User* findUserByUsername(const string& uname) const;
     void listAllUsers() const;
 
+    // Completion API: top matches for a typed prefix, as (name, id) pairs
+    vector<NameTrie::Completion> completeEventName(const string& prefix, size_t limit = COMPLETION_LIMIT) const;
+    vector<NameTrie::Completion> completeInventoryName(const string& prefix, size_t limit = COMPLETION_LIMIT) const;
+    vector<NameTrie::Completion> completeUsername(const string& prefix, size_t limit = COMPLETION_LIMIT) const;
+    // Prompts that also accept a name, or a name prefix ending in '?' to list matches
+    int getEventIdInput(const string& prompt) const;
+    int getInventoryItemIdInput(const string& prompt) const;
+    string getUsernameInput(const string& prompt) const;
+
     // Authentication
     bool login();
     void logout();
@@ -435,19 +2955,49 @@ public:
     void createEvent();
     void viewAllEvents(bool adminView = false) const;
     void searchEventsByNameOrDate() const;
+    vector<const Event*> findEventsInDateRange(const string& fromDate, const string& toDate) const;
+    vector<const Event*> findNextUpcomingEvents(size_t count) const;
+    void searchEventsByDateRange() const;
+    void viewNextUpcomingEvents() const;
+    vector<const Event*> searchEventsByKeywords(const string& query, bool matchAll) const;
+    vector<const Event*> findEventsContaining(const string& text) const;
+    vector<const Event*> findEventsSimilarTo(const string& text) const;
+    vector<const Event*> scanEventDescriptions(const string& text, ScanStats& stats) const;
+    const RoaringBitmap& eventIdsWithStatus(EventStatus status) const;
+    const RoaringBitmap& eventIdsInCategory(const string& category) const;
+    void viewEventStatusCategoryCounts() const;
+    void searchEventDescriptions() const;
+
+    // Query engine: matches are passed to onRow in the requested order, as references into
+    // the live records. Returns a short description of the plan that was used.
+    string queryEvents(const QueryPredicate& where, const QueryOptions& options, const function<void(const Event&)>& onRow) const;
+    string queryAttendees(const QueryPredicate& where, const QueryOptions& options, const function<void(const AttendeeView&)>& onRow) const;
+    void runEventQuery() const;
+    void runAttendeeQuery() const;
+
+    // Set algebra over the people registered for events, by user id (records with no
+    // known owner are left out). Results are ascending user ids.
+    enum class SetOperation { BOTH, EITHER, FIRST_ONLY };
+    vector<int> registeredUserIds(int eventId) const;
+    vector<int> checkedInUserIds() const; // Users checked in to any event
+    vector<int> combineEventRegistrations(int firstEventId, SetOperation op, int secondEventId) const;
+    void compareEventRegistrations() const;
+    void keywordSearchEvents() const;
     void editEventDetails();
     void deleteEvent();
     void updateEventStatus();
 
     // Attendee management
-    Attendee* findAttendeeInMasterList(int attendeeId);
-    const Attendee* findAttendeeInMasterList(int attendeeId) const;
+    AttendeeRef findAttendeeInMasterList(int attendeeId);
+    AttendeeView findAttendeeInMasterList(int attendeeId) const;
     void registerAttendeeForEvent();
     void cancelOwnRegistration();
     void viewAttendeeListsPerEvent() const;
     void checkInAttendeeForEvent();
     void generateAttendanceReportForEvent() const;
     void exportAttendeeListForEventToFile() const; // Specific export for admin, can use strategy
+    vector<AttendeeView> scanAttendeeContacts(const string& text, ScanStats& stats) const;
+    void searchAttendeesByContact() const;
 
     // Inventory management
     InventoryItem* findInventoryItemById(int itemId);
@@ -486,9 +3036,7 @@ User::User(string uname, string pwd, Role r)
 }
 User::User(int id, string uname, string pwd, Role r)
     : userId(id), username(std::move(uname)), password(std::move(pwd)), role(r) {
-    if (id >= nextUserId) {
-        nextUserId = id + 1;
-    }
+    raiseNextId(nextUserId, id);
 }
 User::~User() {}
 
@@ -603,7 +3151,7 @@ void Admin::adminUserManagementMenu(System& sys) {
                 break;
             }
             case 2: {
-                string uname = getStringInput("Enter username to delete: ");
+                string uname = sys.getUsernameInput("Enter username to delete: ");
                 sys.deleteUserAccount(uname);
                 break;
             }
@@ -624,6 +3172,12 @@ void Admin::adminEventManagementMenu(System& sys) {
         cout << "4. Update Event Status\n";
         cout << "5. Delete Event\n";
         cout << "6. Track Inventory Allocation to Event\n";
+        cout << "7. Find Events in Date Range\n";
+        cout << "8. View Next Upcoming Events\n";
+        cout << "9. Keyword Search Events\n";
+        cout << "10. Search Event Descriptions\n";
+        cout << "11. Query Events\n";
+        cout << "12. Event Counts by Status and Category\n";
         cout << "0. Back to Admin Menu\n";
         choice = getIntInput("Enter your choice: ");
 
@@ -634,6 +3188,12 @@ void Admin::adminEventManagementMenu(System& sys) {
             case 4: sys.updateEventStatus(); break;
             case 5: sys.deleteEvent(); break;
             case 6: sys.trackInventoryAllocationToEvent(); break;
+            case 7: sys.searchEventsByDateRange(); break;
+            case 8: sys.viewNextUpcomingEvents(); break;
+            case 9: sys.keywordSearchEvents(); break;
+            case 10: sys.searchEventDescriptions(); break;
+            case 11: sys.runEventQuery(); break;
+            case 12: sys.viewEventStatusCategoryCounts(); break;
             case 0: break;
             default: cout << "Invalid choice. Please try again.\n"; break;
         }
@@ -648,6 +3208,9 @@ void Admin::adminAttendeeManagementMenu(System& sys) {
         cout << "2. Check-in Attendee for Event\n";
         cout << "3. Generate Attendance Report for Event\n";
         cout << "4. Export Attendee List for Event to File\n";
+        cout << "5. Search Attendees by Contact Info\n";
+        cout << "6. Query Attendees\n";
+        cout << "7. Compare Event Registrations\n";
         cout << "0. Back to Admin Menu\n";
         choice = getIntInput("Enter your choice: ");
 
@@ -656,6 +3219,9 @@ void Admin::adminAttendeeManagementMenu(System& sys) {
             case 2: sys.checkInAttendeeForEvent(); break;
             case 3: sys.generateAttendanceReportForEvent(); break;
             case 4: sys.exportAttendeeListForEventToFile(); break;
+            case 5: sys.searchAttendeesByContact(); break;
+            case 6: sys.runAttendeeQuery(); break;
+            case 7: sys.compareEventRegistrations(); break;
             case 0: break;
             default: cout << "Invalid choice. Please try again.\n"; break;
         }
@@ -720,6 +3286,10 @@ void RegularUser::displayMenu(System& sys) {
         cout << "4. Cancel My Registration\n";
         cout << "5. Update My Contact Info\n";
         cout << "6. View My Profile\n";
+        cout << "7. Find Events in Date Range\n";
+        cout << "8. View Next Upcoming Events\n";
+        cout << "9. Keyword Search Events\n";
+        cout << "10. Query Events\n";
         cout << "0. Logout\n";
         choice = getIntInput("Enter your choice: ");
 
@@ -730,6 +3300,10 @@ void RegularUser::displayMenu(System& sys) {
             case 4: sys.cancelOwnRegistration(); break;
             case 5: sys.updateCurrentLoggedInUserContactInfo(); break;
             case 6: sys.currentUser->displayDetails(); break; // Corrected call
+            case 7: sys.searchEventsByDateRange(); break;
+            case 8: sys.viewNextUpcomingEvents(); break;
+            case 9: sys.keywordSearchEvents(); break;
+            case 10: sys.runEventQuery(); break;
             case 0: sys.logout(); break;
             default: cout << "Invalid choice. Please try again.\n"; break;
         }
@@ -748,56 +3322,46 @@ void RegularUser::displayDetails() const {
 
 
 // --- User Factory Method Definition (User::fromString) ---
-User* User::fromString(const string& str) {
-    stringstream ss(str);
-    string segment;
-    int id;
-    string uname, pwd;
-    Role role_val;
-
-    if (str.empty() || count(str.begin(), str.end(), ',') < 3) {
-        cerr << "Warning: Malformed user data line: '" << str << "'. Skipping.\n";
+User* User::fromString(string_view str) {
+    FieldTokenizer fields(str);
+    string_view idField, uname, pwd, roleField;
+    int id = 0, roleValue = 0;
+
+    if (!fields.next(idField) || !fields.next(uname) || !fields.next(pwd) || !fields.next(roleField)) {
+        warningStream() << "Warning: Malformed user data line: '" << str << "'. Skipping.\n";
         return nullptr;
     }
-    try {
-        getline(ss, segment, ','); id = stoi(segment);
-        getline(ss, uname, ',');
-        getline(ss, pwd, ',');
-        getline(ss, segment, ','); role_val = static_cast<Role>(stoi(segment));
-    } catch (const exception& e) {
-        cerr << "Warning: Invalid data format in user line '" << str << "': " << e.what() << ". Skipping.\n";
+    if (!FieldTokenizer::toInt(idField, id) || !FieldTokenizer::toInt(roleField, roleValue)) {
+        warningStream() << "Warning: Invalid data format in user line '" << str << "': expected numeric id and role. Skipping.\n";
         return nullptr;
     }
 
-    if (role_val == Role::ADMIN) {
-        return new Admin(id, uname, pwd);
-    } else if (role_val == Role::REGULAR_USER) {
-        return new RegularUser(id, uname, pwd);
+    User* user = create(id, string(uname), string(pwd), static_cast<Role>(roleValue));
+    if (!user) {
+        warningStream() << "Warning: Unknown role in user data line: '" << str << "'. Skipping.\n";
+    }
+    return user;
+}
+
+User* User::create(int id, string uname, string pwd, Role role) {
+    if (role == Role::ADMIN) {
+        return new Admin(id, std::move(uname), std::move(pwd));
+    } else if (role == Role::REGULAR_USER) {
+        return new RegularUser(id, std::move(uname), std::move(pwd));
     }
-    cerr << "Warning: Unknown role in user data line: '" << str << "'. Skipping.\n";
     return nullptr;
 }
 
 
 // --- Attendee Class Method Definitions ---
-Attendee::Attendee(string n, string contact, int eventId)
-    : name(std::move(n)), contactInfo(std::move(contact)), eventIdRegisteredFor(eventId), isCheckedIn(false) {
+Attendee::Attendee(string n, string contact, int eventId, int ownerId)
+    : name(std::move(n)), contactInfo(std::move(contact)), eventIdRegisteredFor(eventId), isCheckedIn(false), userId(ownerId) {
     attendeeId = nextAttendeeId++;
 }
-Attendee::Attendee(int id, string n, string contact, int eventId, bool checkedInStatus)
+Attendee::Attendee(int id, string n, string contact, int eventId, bool checkedInStatus, int ownerId)
     : attendeeId(id), name(std::move(n)), contactInfo(std::move(contact)),
-      eventIdRegisteredFor(eventId), isCheckedIn(checkedInStatus) {
-    if (id >= nextAttendeeId) {
-        nextAttendeeId = id + 1;
-    }
-}
-void Attendee::checkIn() {
-    if (!isCheckedIn) {
-        isCheckedIn = true;
-        cout << name << " checked in successfully for event ID " << eventIdRegisteredFor << ".\n";
-    } else {
-        cout << name << " is already checked in for event ID " << eventIdRegisteredFor << ".\n";
-    }
+      eventIdRegisteredFor(eventId), isCheckedIn(checkedInStatus), userId(ownerId) {
+    raiseNextId(nextAttendeeId, id);
 }
 void Attendee::displayDetails() const {
     cout << "Attendee ID: " << attendeeId
@@ -808,39 +3372,47 @@ void Attendee::displayDetails() const {
 }
 string Attendee::toString() const {
     stringstream ss;
-    ss << attendeeId << "," << name << "," << contactInfo << "," << eventIdRegisteredFor << "," << (isCheckedIn ? "1" : "0");
+    ss << attendeeId << "," << name << "," << contactInfo << "," << eventIdRegisteredFor << "," << (isCheckedIn ? "1" : "0") << "," << userId;
     return ss.str();
 }
-Attendee Attendee::fromString(const string& str) {
-    stringstream ss(str);
-    string segment;
-    int id, eventId;
-    string name, contact;
-    bool checkedIn;
-    // Error handling for stoi for robustness in case of malformed data
-    try {
-        getline(ss, segment, ','); id = stoi(segment);
-        getline(ss, name, ',');
-        getline(ss, contact, ',');
-        getline(ss, segment, ','); eventId = stoi(segment);
-        getline(ss, segment, ','); checkedIn = (segment == "1");
-    } catch (const exception& e) {
-        cerr << "Warning: Malformed attendee data line: '" << str << "'. Defaulting values. Error: " << e.what() << "\n";
+Attendee Attendee::fromString(string_view str) {
+    FieldTokenizer fields(str);
+    string_view idField, name, contact, eventField, checkedField;
+    int id = 0, eventId = 0;
+    // Malformed numbers are reported instead of thrown, for robustness with hand-edited files
+    if (!fields.next(idField) || !fields.next(name) || !fields.next(contact) || !fields.next(eventField) ||
+        !FieldTokenizer::toInt(idField, id) || !FieldTokenizer::toInt(eventField, eventId)) {
+        warningStream() << "Warning: Malformed attendee data line: '" << str << "'. Defaulting values.\n";
         return Attendee(0, "ERROR", "ERROR", 0, false); // Return a default/error attendee
     }
-    return Attendee(id, name, contact, eventId, checkedIn);
+    bool checkedIn = fields.next(checkedField) && checkedField == "1";
+    // Files written before registrations carried a user id have no sixth field
+    string_view ownerField;
+    int ownerId = 0;
+    if (fields.next(ownerField) && !FieldTokenizer::toInt(ownerField, ownerId)) ownerId = 0;
+    return Attendee(id, string(name), string(contact), eventId, checkedIn, ownerId);
+}
+void AttendeeRef::checkIn() const {
+    if (!isCheckedIn()) {
+        setCheckedIn(true);
+        cout << name() << " checked in successfully for event ID " << eventIdRegisteredFor() << ".\n";
+    } else {
+        cout << name() << " is already checked in for event ID " << eventIdRegisteredFor() << ".\n";
+    }
 }
 
 // --- InventoryItem Class Method Definitions ---
-InventoryItem::InventoryItem(string n, int qty, string desc)
-    : name(std::move(n)), totalQuantity(qty), allocatedQuantity(0), description(std::move(desc)) {
+InventoryItem::InventoryItem(string n, int qty, InternedString desc)
+    : name(std::move(n)), nameKey(toLower(name)), totalQuantity(qty), allocatedQuantity(0), description(desc) {
     itemId = nextItemId++;
 }
-InventoryItem::InventoryItem(int id, string n, int totalQty, int allocQty, string desc)
-    : itemId(id), name(std::move(n)), totalQuantity(totalQty), allocatedQuantity(allocQty), description(std::move(desc)) {
-    if (id >= nextItemId) {
-        nextItemId = id + 1;
-    }
+InventoryItem::InventoryItem(int id, string n, int totalQty, int allocQty, InternedString desc)
+    : itemId(id), name(std::move(n)), nameKey(toLower(name)), totalQuantity(totalQty), allocatedQuantity(allocQty), description(desc) {
+    raiseNextId(nextItemId, id);
+}
+void InventoryItem::setName(string newName) {
+    name = std::move(newName);
+    nameKey = toLower(name);
 }
 int InventoryItem::getAvailableQuantity() const { return totalQuantity - allocatedQuantity; }
 bool InventoryItem::allocate(int quantityToAllocate) {
@@ -861,14 +3433,15 @@ bool InventoryItem::deallocate(int quantityToDeallocate) {
     cout << "Error: Cannot deallocate " << quantityToDeallocate << " of '" << name << "'. Allocated: " << allocatedQuantity << endl;
     return false;
 }
-void InventoryItem::setTotalQuantity(int newTotalQuantity) {
-    if (newTotalQuantity < 0) { cout << "Error: Total quantity cannot be negative.\n"; return; }
+bool InventoryItem::setTotalQuantity(int newTotalQuantity) {
+    if (newTotalQuantity < 0) { cout << "Error: Total quantity cannot be negative.\n"; return false; }
     if (newTotalQuantity < allocatedQuantity) {
         cout << "Error: New total quantity (" << newTotalQuantity << ") cannot be less than allocated (" << allocatedQuantity << ").\n";
-        return;
+        return false;
     }
     totalQuantity = newTotalQuantity;
     cout << "Total quantity for '" << name << "' updated to " << totalQuantity << ".\n";
+    return true;
 }
 void InventoryItem::displayDetails() const {
     cout << "Item ID: " << itemId << ", Name: " << name
@@ -882,62 +3455,59 @@ string InventoryItem::toString() const {
     ss << itemId << "," << name << "," << totalQuantity << "," << allocatedQuantity << "," << description;
     return ss.str();
 }
-InventoryItem InventoryItem::fromString(const string& str) {
-    stringstream ss(str);
-    string segment, name, desc;
-    int id, totalQty, allocQty;
-    try {
-        getline(ss, segment, ','); id = stoi(segment);
-        getline(ss, name, ',');
-        getline(ss, segment, ','); totalQty = stoi(segment);
-        getline(ss, segment, ','); allocQty = stoi(segment);
-        getline(ss, desc); // Read the rest as description
-    } catch (const exception& e) {
-        cerr << "Warning: Malformed inventory data line: '" << str << "'. Defaulting values. Error: " << e.what() << "\n";
-        return InventoryItem(0, "ERROR", 0, 0, "ERROR"); // Return a default/error item
+InventoryItem InventoryItem::fromString(string_view str) {
+    FieldTokenizer fields(str);
+    string_view idField, name, totalField, allocField;
+    int id = 0, totalQty = 0, allocQty = 0;
+    if (!fields.next(idField) || !fields.next(name) || !fields.next(totalField) || !fields.next(allocField) ||
+        !FieldTokenizer::toInt(idField, id) || !FieldTokenizer::toInt(totalField, totalQty) ||
+        !FieldTokenizer::toInt(allocField, allocQty)) {
+        warningStream() << "Warning: Malformed inventory data line: '" << str << "'. Defaulting values.\n";
+        return InventoryItem(0, "ERROR", 0, 0, InternedString("ERROR")); // Return a default/error item
     }
-    return InventoryItem(id, name, totalQty, allocQty, desc);
+    string_view desc = fields.remainder(); // The rest of the line is the description
+    return InventoryItem(id, string(name), totalQty, allocQty, InternedString(desc));
 }
 
 // --- Event Class Method Definitions ---
-Event::Event(string n, string d, string t, string loc, string desc, string cat)
-    : name(std::move(n)), date(std::move(d)), time(std::move(t)), location(std::move(loc)),
-      description(std::move(desc)), category(std::move(cat)), status(EventStatus::UPCOMING) {
+Event::Event(string n, PackedDate d, PackedTime t, InternedString loc, string desc, InternedString cat)
+    : date(d), time(t), status(EventStatus::UPCOMING), name(std::move(n)),
+      details(new EventDetails{ loc, std::move(desc), cat, {}, {}, {}, {} }) {
     eventId = nextEventId++;
 }
-Event::Event(int id, string n, string d, string t, string loc,
-      string desc, string cat, EventStatus stat)
-    : eventId(id), name(std::move(n)), date(std::move(d)), time(std::move(t)), location(std::move(loc)),
-      description(std::move(desc)), category(std::move(cat)), status(stat) {
-    if (id >= nextEventId) {
-        nextEventId = id + 1;
-    }
+Event::Event(int id, string n, PackedDate d, PackedTime t, InternedString loc,
+      string desc, InternedString cat, EventStatus stat)
+    : eventId(id), date(d), time(t), status(stat), name(std::move(n)),
+      details(new EventDetails{ loc, std::move(desc), cat, {}, {}, {}, {} }) {
+    raiseNextId(nextEventId, id);
+}
+Event::Event(const Event& other)
+    : eventId(other.eventId), date(other.date), time(other.time), status(other.status), name(other.name),
+      details(make_unique<EventDetails>(*other.details)) {}
+Event& Event::operator=(const Event& other) {
+    if (this != &other) *this = Event(other);
+    return *this;
 }
 void Event::addAttendee(int attId) {
-    if (find(attendeeIds.begin(), attendeeIds.end(), attId) == attendeeIds.end()) {
-        attendeeIds.push_back(attId);
-    } else {
+    if (!details->attendeeIds.insert(attId)) {
         cout << "Info: Attendee ID " << attId << " already registered for event '" << name << "'.\n";
     }
 }
 void Event::removeAttendee(int attId) {
-    auto it = find(attendeeIds.begin(), attendeeIds.end(), attId);
-    if (it != attendeeIds.end()) {
-        attendeeIds.erase(it);
-    }
+    details->attendeeIds.erase(attId);
 }
 void Event::allocateInventoryItem(int itmId, int quantity) {
-    if (quantity > 0) allocatedInventory[itmId] += quantity;
+    if (quantity > 0) details->allocatedInventory[itmId] += quantity;
 }
 int Event::deallocateInventoryItem(int itmId, int quantityToDeallocate) {
     if (quantityToDeallocate <= 0) return 0;
-    auto it = allocatedInventory.find(itmId);
-    if (it != allocatedInventory.end()) {
+    auto it = details->allocatedInventory.find(itmId);
+    if (it != details->allocatedInventory.end()) {
         int currentQty = it->second;
         int actualDeallocated = min(currentQty, quantityToDeallocate);
         it->second -= actualDeallocated;
         if (it->second <= 0) {
-            allocatedInventory.erase(it);
+            details->allocatedInventory.erase(it);
         }
         return actualDeallocated;
     }
@@ -954,113 +3524,120 @@ string Event::getStatusString() const {
 }
 string Event::attendeesToString() const {
     stringstream ss;
-    for (size_t i = 0; i < attendeeIds.size(); ++i) {
-        ss << attendeeIds[i] << (i == attendeeIds.size() - 1 ? "" : ";");
+    bool first = true;
+    for (int attId : details->attendeeIds) {
+        ss << (first ? "" : ";") << attId;
+        first = false;
     }
     return ss.str();
 }
 string Event::inventoryToString() const {
     stringstream ss;
     bool first = true;
-    for (const auto& pair : allocatedInventory) {
+    for (const auto& pair : details->allocatedInventory) {
         if (!first) ss << ";";
         ss << pair.first << ":" << pair.second;
         first = false;
     }
     return ss.str();
 }
-string Event::toString() const {
+string Event::headerToString() const {
     stringstream ss;
-    ss << eventId << "," << name << "," << date << "," << time << "," << location << ","
-       << description << "," << category << "," << static_cast<int>(status) << ","
-       << attendeesToString() << "," << inventoryToString();
+    ss << eventId << "," << name << "," << dateText() << "," << timeText() << "," << details->location << ","
+       << details->description << "," << details->category << "," << static_cast<int>(status);
     return ss.str();
 }
-Event Event::fromString(const string& str) {
-    stringstream ss(str);
-    string segment, name, date_str, time_str, loc, desc, cat, attendeesStr, inventoryStr;
-    int id;
-    EventStatus stat;
-    try {
-        getline(ss, segment, ','); id = stoi(segment);
-        getline(ss, name, ',');
-        getline(ss, date_str, ',');
-        getline(ss, time_str, ',');
-        getline(ss, loc, ',');
-        getline(ss, desc, ',');
-        getline(ss, cat, ',');
-        getline(ss, segment, ','); stat = static_cast<EventStatus>(stoi(segment));
-        // Read remaining segments for attendees and inventory. Use ss.peek() to check if more data exists.
-        if (ss.peek() == ',') {
-            getline(ss, segment, ','); // consume the comma
-            if (ss.peek() != ',' && ss.good()) { // Check if next char is not comma, and stream is good
-                getline(ss, attendeesStr, ',');
-            } else {
-                attendeesStr = "";
-            }
-        } else {
-            attendeesStr = ""; // No comma after status, so no attendees data
-        }
-
-        if (ss.good() && ss.peek() != EOF) { // Check if there's more data for inventory
-            getline(ss, inventoryStr); // Read the rest of the line
-        } else {
-            inventoryStr = "";
-        }
-
-    } catch (const exception& e) {
-        cerr << "Warning: Malformed event data line: '" << str << "'. Defaulting values. Error: " << e.what() << "\n";
-        return Event(0, "ERROR", "ERROR", "ERROR", "ERROR", "ERROR"); // Return a default/error event
+string Event::toString() const {
+    return headerToString() + "," + attendeesToString() + "," + inventoryToString();
+}
+Event Event::fromString(string_view str) {
+    FieldTokenizer fields(str);
+    string_view idField, name, date_str, time_str, loc, desc, cat, statusField;
+    int id = 0, statusValue = 0;
+    if (!fields.next(idField) || !fields.next(name) || !fields.next(date_str) || !fields.next(time_str) ||
+        !fields.next(loc) || !fields.next(desc) || !fields.next(cat) || !fields.next(statusField) ||
+        !FieldTokenizer::toInt(idField, id) || !FieldTokenizer::toInt(statusField, statusValue)) {
+        warningStream() << "Warning: Malformed event data line: '" << str << "'. Defaulting values.\n";
+        return Event(0, "ERROR", INVALID_DATE, INVALID_TIME, InternedString("ERROR"), "ERROR", InternedString("ERROR"), EventStatus::UPCOMING); // Return a default/error event
     }
-
-    Event event(id, name, date_str, time_str, loc, desc, cat, stat);
-
-    if (!attendeesStr.empty()) {
-        stringstream attSs(attendeesStr);
-        string attIdStr;
-        while (getline(attSs, attIdStr, ';')) {
-            if(!attIdStr.empty()) event.attendeeIds.push_back(stoi(attIdStr));
+    // Optional trailing fields: attendee ids, then the inventory allocations as the rest of the line
+    string_view attendeesStr, inventoryStr;
+    fields.next(attendeesStr);
+    inventoryStr = fields.remainder();
+
+    if (statusValue < 0 || statusValue >= EVENT_STATUS_COUNT) {
+        warningStream() << "Warning: Invalid status " << statusValue << " for event " << id << ". Loading it as Upcoming.\n";
+        statusValue = static_cast<int>(EventStatus::UPCOMING);
+    }
+    // Dates the packed form cannot hold (older files accepted e.g. 2025-02-31) keep their text
+    PackedDate date = parseDate(date_str);
+    PackedTime time = parseTime(time_str);
+    if (date == INVALID_DATE) {
+        warningStream() << "Warning: Unreadable date '" << date_str << "' for event " << id << ". Keeping it as stored.\n";
+    }
+    if (time == INVALID_TIME) {
+        warningStream() << "Warning: Unreadable time '" << time_str << "' for event " << id << ". Keeping it as stored.\n";
+    }
+    Event event(id, string(name), date, time, InternedString(loc), string(desc), InternedString(cat),
+                static_cast<EventStatus>(statusValue));
+    if (date == INVALID_DATE) event.details->storedDate = string(date_str);
+    if (time == INVALID_TIME) event.details->storedTime = string(time_str);
+
+    FieldTokenizer attendeeFields(attendeesStr, ';');
+    string_view attIdStr;
+    while (attendeeFields.next(attIdStr)) {
+        if (attIdStr.empty()) continue;
+        int attId = 0;
+        if (FieldTokenizer::toInt(attIdStr, attId)) {
+            event.details->attendeeIds.insert(attId);
+        } else {
+            warningStream() << "Warning: Malformed attendee id in event line: '" << attIdStr << "'. Skipping.\n";
         }
     }
-    if (!inventoryStr.empty()) {
-        stringstream invSs(inventoryStr);
-        string itemStr;
-        while (getline(invSs, itemStr, ';')) {
-            if(!itemStr.empty()){
-                size_t colonPos = itemStr.find(':');
-                if (colonPos != string::npos) {
-                    try {
-                        event.allocatedInventory[stoi(itemStr.substr(0, colonPos))] = stoi(itemStr.substr(colonPos + 1));
-                    } catch (const exception& e) {
-                        cerr << "Warning: Malformed inventory item in event line: '" << itemStr << "'. Skipping. Error: " << e.what() << "\n";
-                    }
-                }
-            }
+    FieldTokenizer inventoryFields(inventoryStr, ';');
+    string_view itemStr;
+    while (inventoryFields.next(itemStr)) {
+        if (itemStr.empty()) continue;
+        size_t colonPos = itemStr.find(':');
+        int itemId = 0, quantity = 0;
+        if (colonPos != string_view::npos && FieldTokenizer::toInt(itemStr.substr(0, colonPos), itemId) &&
+            FieldTokenizer::toInt(itemStr.substr(colonPos + 1), quantity)) {
+            event.details->allocatedInventory[itemId] = quantity;
+        } else {
+            warningStream() << "Warning: Malformed inventory item in event line: '" << itemStr << "'. Skipping.\n";
         }
     }
     return event;
 }
 
+string Event::dateText() const {
+    return date == INVALID_DATE ? details->storedDate : formatDate(date);
+}
+string Event::timeText() const {
+    return time == INVALID_TIME ? details->storedTime : formatTime(time);
+}
+
 void Event::displayDetails(const System& sys) const {
     cout << "Event ID: " << eventId << "\n"
          << "Name: " << name << "\n"
-         << "Date: " << date << "\n"
-         << "Time: " << time << "\n"
-         << "Location: " << location << "\n"
-         << "Description: " << description << "\n"
-         << "Category: " << category << "\n"
+         << "Date: " << dateText() << "\n"
+         << "Time: " << timeText() << "\n"
+         << "Location: " << details->location << "\n"
+         << "Description: " << details->description << "\n"
+         << "Category: " << details->category << "\n"
          << "Status: " << getStatusString() << "\n";
 
+    const AttendeeSet& attendeeIds = details->attendeeIds;
     cout << "  Attendees (" << attendeeIds.size() << "): ";
     if (attendeeIds.empty()) {
         cout << "None\n";
     } else {
         bool first = true;
         for (int attId : attendeeIds) {
-            const Attendee* att = sys.findAttendeeInMasterList(attId);
+            AttendeeView att = sys.findAttendeeInMasterList(attId);
             if (!first) cout << ", ";
             if (att) {
-                cout << att->name << " (ID:" << att->attendeeId << (att->isCheckedIn ? " - Checked In" : "") << ")";
+                cout << att.name() << " (ID:" << att.attendeeId() << (att.isCheckedIn() ? " - Checked In" : "") << ")";
             } else {
                 cout << "Unknown Attendee (ID:" << attId << ")";
             }
@@ -1069,6 +3646,7 @@ void Event::displayDetails(const System& sys) const {
         cout << "\n";
     }
 
+    const FlatMap<int, int>& allocatedInventory = details->allocatedInventory;
     cout << "  Allocated Inventory: ";
     if (allocatedInventory.empty()) {
         cout << "None\n";
@@ -1099,11 +3677,15 @@ System::~System() {
     }
     users.clear();
 
-    // Delete the export strategy
+    // Delete the export strategies
     if (exportStrategy != nullptr) {
         delete exportStrategy;
         exportStrategy = nullptr;
     }
+    if (snapshotStrategy != nullptr) {
+        delete snapshotStrategy;
+        snapshotStrategy = nullptr;
+    }
 }
 
 void System::seedInitialData() {
@@ -1111,27 +3693,33 @@ void System::seedInitialData() {
     if (users.empty()) {
         cout << "Info: No users found. Seeding initial accounts.\n";
         users.push_back(new Admin("admin", "adminpass"));
+        indexUser(users.back());
         cout << "Seeded Admin: admin (ID: " << users.back()->getUserId() << ")\n";
         users.push_back(new RegularUser("user1", "user1pass"));
+        indexUser(users.back());
         cout << "Seeded User: user1 (ID: " << users.back()->getUserId() << ")\n";
         users.push_back(new RegularUser("user2", "user2pass"));
+        indexUser(users.back());
         cout << "Seeded User: user2 (ID: " << users.back()->getUserId() << ")\n";
+        markDirty(DataTable::USERS);
         dataSeeded = true;
     }
     if (events.empty()) {
         cout << "Info: No events found. Seeding initial events.\n";
-        events.emplace_back("Tech Conference 2025", "2025-10-20", "09:00", "Grand Hall", "Annual tech conference", "Conference");
-        cout << "Seeded Event: Tech Conference 2025 (ID: " << events.back().eventId << ")\n";
-        events.emplace_back("Summer Music Festival", "2025-07-15", "14:00", "City Park", "Outdoor music event", "Social");
-        cout << "Seeded Event: Summer Music Festival (ID: " << events.back().eventId << ")\n";
+        const Event& conference = insertEvent(Event("Tech Conference 2025", makeDate(2025, 10, 20), 9 * 60, InternedString("Grand Hall"), "Annual tech conference", InternedString("Conference")));
+        cout << "Seeded Event: Tech Conference 2025 (ID: " << conference.eventId << ")\n";
+        const Event& festival = insertEvent(Event("Summer Music Festival", makeDate(2025, 7, 15), 14 * 60, InternedString("City Park"), "Outdoor music event", InternedString("Social")));
+        cout << "Seeded Event: Summer Music Festival (ID: " << festival.eventId << ")\n";
+        markDirty(DataTable::EVENTS);
         dataSeeded = true;
     }
     if (inventory.empty()) {
         cout << "Info: No inventory found. Seeding initial items.\n";
-        inventory.emplace_back("Projector", 5, "HD Projector");
-        cout << "Seeded Inventory: Projector (ID: " << inventory.back().itemId << ")\n";
-        inventory.emplace_back("Chairs", 100, "Standard chairs");
-        cout << "Seeded Inventory: Chairs (ID: " << inventory.back().itemId << ")\n";
+        const InventoryItem& projector = insertInventoryItem(InventoryItem("Projector", 5, InternedString("HD Projector")));
+        cout << "Seeded Inventory: Projector (ID: " << projector.itemId << ")\n";
+        const InventoryItem& chairs = insertInventoryItem(InventoryItem("Chairs", 100, InternedString("Standard chairs")));
+        cout << "Seeded Inventory: Chairs (ID: " << chairs.itemId << ")\n";
+        markDirty(DataTable::INVENTORY);
         dataSeeded = true;
     }
     if (dataSeeded) {
@@ -1141,108 +3729,467 @@ void System::seedInitialData() {
 }
 
 void System::loadData() {
-    loadUsers(); loadEvents(); loadInventory(); loadAttendees();
+    // The four tables are independent, so they are loaded concurrently. Each loader keeps its
+    // warnings, and they are printed in table order once all four are done.
+    string warnings[4];
+    auto load = [this](void (System::*loader)(), string& tableWarnings) {
+        LocalWarningLog warningLog;
+        (this->*loader)();
+        tableWarnings = warningLog.text.str();
+    };
+    thread usersLoader(load, &System::loadUsers, ref(warnings[0]));
+    thread eventsLoader(load, &System::loadEvents, ref(warnings[1]));
+    thread inventoryLoader(load, &System::loadInventory, ref(warnings[2]));
+    load(&System::loadAttendees, warnings[3]);
+    usersLoader.join(); eventsLoader.join(); inventoryLoader.join();
+    for (const auto& tableWarnings : warnings) cerr << tableWarnings;
+    rebuildEventIndex(); rebuildAttendeeIndex(); rebuildInventoryIndex(); rebuildUserIndex();
+    rebuildEventSearchIndexes();
+    replayJournal(); // Apply changes made since the last full save
+    resolveAttendeeOwners();
     // Re-initialize next IDs based on loaded data to prevent ID collisions
     int maxId = 0; for(const auto* u : users) if(u && u->getUserId() > maxId) maxId = u->getUserId(); User::initNextId(maxId);
     maxId = 0; for(const auto& e : events) if(e.eventId > maxId) maxId = e.eventId; Event::initNextId(maxId);
     maxId = 0; for(const auto& i : inventory) if(i.itemId > maxId) maxId = i.itemId; InventoryItem::initNextId(maxId);
-    maxId = 0; for(const auto& a : allAttendees) if(a.attendeeId > maxId) maxId = a.attendeeId; Attendee::initNextId(maxId);
+    maxId = 0; for(const auto& a : allAttendees) if(a.attendeeId() > maxId) maxId = a.attendeeId(); Attendee::initNextId(maxId);
 
     // After loading, ensure allocated quantities are consistent with events
+    vector<int> loadedAllocations;
     for (auto& item : inventory) {
+        loadedAllocations.push_back(item.allocatedQuantity);
         item.allocatedQuantity = 0; // Reset allocated quantities for re-calculation
     }
+    // Hash join of event allocations against inventory items (through inventorySlots)
     for (const auto& event : events) {
-        for (const auto& invPair : event.allocatedInventory) {
+        for (const auto& invPair : event.details->allocatedInventory) {
             InventoryItem* item = findInventoryItemById(invPair.first);
             if (item) {
                 item->allocatedQuantity += invPair.second;
             }
         }
     }
+    size_t position = 0;
+    for (const auto& item : inventory) {
+        if (item.allocatedQuantity != loadedAllocations[position++]) {
+            markDirty(DataTable::INVENTORY); // inventory.txt is out of date
+            break;
+        }
+    }
 }
 
 void System::saveData() {
-    saveUsers();
-    saveEvents();
-    saveInventory();
-    saveAttendees();
+    // Only tables changed since their last write are saved; a burst of edits costs one write per table
+    bool saved = true;
+    if (isDirty(DataTable::USERS) && !saveUsers()) saved = false;
+    if (isDirty(DataTable::EVENTS) && !saveEvents()) saved = false;
+    if (isDirty(DataTable::INVENTORY) && !saveInventory()) saved = false;
+    if (isDirty(DataTable::ATTENDEES) && !saveAttendees()) saved = false;
+    if (!journal.empty()) {
+        if (saved) {
+            journal.clear(); // Everything journaled, or still pending, is now in the data files
+        } else {
+            // The journal is the only copy of the changes a failed table write missed
+            cerr << "Warning: Not every table could be saved; keeping " << JOURNAL_FILE << " for recovery.\n";
+        }
+    }
+    compactStorage(); // A quiet point to reclaim the slots of deleted records
 }
 
-void System::loadUsers() {
-    ifstream inFile(USERS_FILE); if (!inFile) return;
-    string line;
-    while (getline(inFile, line)) {
-        if (!line.empty()) {
-            User* u = User::fromString(line);
-            if(u) users.push_back(u);
+void System::recordChange(const string& entry) {
+    journal.record(entry);
+    markDirtyForJournalEntry(entry);
+}
+
+void System::markDirtyForJournalEntry(const string& entry) {
+    string op = entry.substr(0, entry.find(','));
+    if (op == "USER+" || op == "USER-") {
+        markDirty(DataTable::USERS);
+    } else if (op == "EVENT+" || op == "REG+" || op == "REG-") {
+        markDirty(DataTable::EVENTS);
+    } else if (op == "EVENT-") {
+        markDirty(DataTable::EVENTS);
+        markDirty(DataTable::ATTENDEES);
+        markDirty(DataTable::INVENTORY);
+    } else if (op == "ATTENDEE+" || op == "ATTENDEE-" || op == "CHECKIN") {
+        markDirty(DataTable::ATTENDEES);
+    } else if (op == "ITEM+") {
+        markDirty(DataTable::INVENTORY);
+    } else if (op == "ALLOC") {
+        markDirty(DataTable::EVENTS);
+        markDirty(DataTable::INVENTORY);
+    }
+}
+
+void System::commitJournal() {
+    if (!journal.commit()) {
+        // Journal unavailable: fall back to a full save so the change is not lost. A successful
+        // save also drops the pending entries, so they are not appended again on the next commit.
+        saveData();
+        return;
+    }
+    if (journal.size() >= JOURNAL_CHECKPOINT_ENTRIES) {
+        saveData();
+    }
+}
+
+void System::replayJournal() {
+    vector<string> entries = journal.readEntries();
+    for (const auto& entry : entries) {
+        applyJournalEntry(entry);
+        markDirtyForJournalEntry(entry); // The data files do not have this change yet
+    }
+    if (!entries.empty()) {
+        cout << "Info: Replayed " << entries.size() << " journal entries from " << JOURNAL_FILE << ".\n";
+    }
+}
+
+// Journal entries are "OP,payload". Record entries carry the same line format as the
+// data files; every entry is idempotent, so replaying over a partially saved snapshot is safe.
+//   USER+,<user>        USER-,<userId>
+//   EVENT+,<event header> (lists kept)   EVENT-,<eventId> (also drops its registrations)
+//   ATTENDEE+,<attendee>  ATTENDEE-,<attendeeId>   CHECKIN,<attendeeId>
+//   REG+,<eventId>,<attendeeId>   REG-,<eventId>,<attendeeId>
+//   ITEM+,<item>        ALLOC,<eventId>,<itemId>,<quantity now allocated>
+void System::applyJournalEntry(const string& entry) {
+    size_t comma = entry.find(',');
+    string op = entry.substr(0, comma);
+    string payload = (comma == string::npos) ? "" : entry.substr(comma + 1);
+
+    vector<int> args; // Integer arguments for the id-only operations
+    if (op != "USER+" && op != "EVENT+" && op != "ATTENDEE+" && op != "ITEM+") {
+        FieldTokenizer fields(payload);
+        string_view field;
+        int value = 0;
+        while (fields.next(field)) {
+            if (!FieldTokenizer::toInt(field, value)) {
+                cerr << "Warning: Malformed journal entry: '" << entry << "'. Skipping.\n";
+                return;
+            }
+            args.push_back(value);
         }
     }
-    inFile.close();
+
+    if (op == "USER+") {
+        User* u = User::fromString(payload);
+        if (!u) return;
+        for (auto*& existing : users) {
+            if (existing && existing->getUserId() == u->getUserId()) {
+                unindexUser(existing);
+                delete existing;
+                existing = u;
+                indexUser(u);
+                return;
+            }
+        }
+        users.push_back(u);
+        indexUser(u);
+    } else if (op == "USER-" && args.size() == 1) {
+        users.erase(remove_if(users.begin(), users.end(), [&](User* u) {
+            if (u && u->getUserId() == args[0]) {
+                unindexUser(u);
+                delete u;
+                return true;
+            }
+            return false;
+        }), users.end());
+    } else if (op == "EVENT+") {
+        Event updated = Event::fromString(payload);
+        Event* existing = findEventById(updated.eventId);
+        if (existing) {
+            updated.details->attendeeIds = existing->details->attendeeIds;
+            updated.details->allocatedInventory = existing->details->allocatedInventory;
+            removeFromEventIndexes(*existing);
+            *existing = updated;
+            addToEventIndexes(*existing);
+        } else {
+            insertEvent(updated);
+        }
+    } else if (op == "EVENT-" && args.size() == 1) {
+        int eventId = args[0];
+        if (const Event* event = findEventById(eventId)) removeFromEventIndexes(*event);
+        eraseAttendeesOfEvent(eventId);
+        eraseEventRecord(eventId);
+    } else if (op == "ATTENDEE+") {
+        Attendee updated = Attendee::fromString(payload);
+        AttendeeRef existing = findAttendeeInMasterList(updated.attendeeId);
+        if (existing) {
+            if (existing.userId() != updated.userId || existing.eventIdRegisteredFor() != updated.eventIdRegisteredFor) {
+                unindexRegistration(updated.attendeeId, existing.eventIdRegisteredFor(), existing.userId());
+                indexRegistration(updated.attendeeId, updated.eventIdRegisteredFor, updated.userId);
+            }
+            existing.assign(updated);
+        } else {
+            insertAttendee(updated);
+        }
+    } else if (op == "ATTENDEE-" && args.size() == 1) {
+        eraseAttendeeRecord(args[0]);
+    } else if (op == "CHECKIN" && args.size() == 1) {
+        AttendeeRef att = findAttendeeInMasterList(args[0]);
+        if (att) att.setCheckedIn(true);
+    } else if ((op == "REG+" || op == "REG-") && args.size() == 2) {
+        Event* event = findEventById(args[0]);
+        if (!event) return;
+        bool registered = event->details->attendeeIds.contains(args[1]);
+        if (op == "REG+" && !registered) event->addAttendee(args[1]);
+        if (op == "REG-" && registered) event->removeAttendee(args[1]);
+    } else if (op == "ITEM+") {
+        InventoryItem updated = InventoryItem::fromString(payload);
+        InventoryItem* existing = findInventoryItemById(updated.itemId);
+        if (existing) {
+            if (existing->nameKey != updated.nameKey) renameInventoryItem(*existing, updated.name);
+            *existing = updated;
+        } else {
+            insertInventoryItem(updated);
+        }
+    } else if (op == "ALLOC" && args.size() == 3) {
+        Event* event = findEventById(args[0]);
+        if (!event) return;
+        if (args[2] > 0) {
+            event->details->allocatedInventory[args[1]] = args[2];
+        } else {
+            event->details->allocatedInventory.erase(args[1]);
+        }
+    } else {
+        cerr << "Warning: Unknown journal entry: '" << entry << "'. Skipping.\n";
+    }
+}
+
+void System::loadUsers() {
+    if (loadUsersSnapshot()) return;
+    string contents;
+    if (!readWholeFile(USERS_FILE, contents)) return;
+    markDirty(DataTable::USERS);
+    vector<User*> loaded = parseLinesInParallel<User*>(contents, [](string_view line, vector<User*>& out) {
+        User* u = User::fromString(line);
+        if(u) out.push_back(u);
+    });
+    users.insert(users.end(), loaded.begin(), loaded.end());
 }
 
-void System::saveUsers() {
+bool System::saveUsers() {
     if (exportStrategy) {
-        exportStrategy->exportUsers(users, USERS_FILE);
+        bool saved = exportStrategy->exportUsers(users, USERS_FILE);
+        if (snapshotStrategy && !snapshotStrategy->exportUsers(users, USERS_SNAPSHOT)) saved = false;
+        if (saved) dirtyTables[static_cast<int>(DataTable::USERS)] = false; // A failed table is retried on the next save
+        return saved;
     } else {
         cerr << "Error: No export strategy set for saving users.\n";
+        return false;
     }
 }
 
 void System::loadEvents() {
-    ifstream inFile(EVENTS_FILE); if (!inFile) return;
-    string line;
-    while (getline(inFile, line)) {
-        if (!line.empty()) events.push_back(Event::fromString(line));
+    if (loadEventsSnapshot()) return;
+    string contents;
+    if (!readWholeFile(EVENTS_FILE, contents)) return;
+    markDirty(DataTable::EVENTS);
+    vector<Event> loaded = parseLinesInParallel<Event>(contents, [](string_view line, vector<Event>& out) {
+        out.push_back(Event::fromString(line));
+    });
+    for (auto& record : loaded) events.insert(std::move(record));
+}
+
+bool System::saveEvents() {
+    if (exportStrategy) {
+        bool saved = exportStrategy->exportEvents(events, EVENTS_FILE, *this);
+        if (snapshotStrategy && !snapshotStrategy->exportEvents(events, EVENTS_SNAPSHOT, *this)) saved = false;
+        if (saved) dirtyTables[static_cast<int>(DataTable::EVENTS)] = false;
+        return saved;
+    } else {
+        cerr << "Error: No export strategy set for saving events.\n";
+        return false;
+    }
+}
+
+void System::loadInventory() {
+    if (loadInventorySnapshot()) return;
+    string contents;
+    if (!readWholeFile(INVENTORY_FILE, contents)) return;
+    markDirty(DataTable::INVENTORY);
+    vector<InventoryItem> loaded = parseLinesInParallel<InventoryItem>(contents, [](string_view line, vector<InventoryItem>& out) {
+        out.push_back(InventoryItem::fromString(line));
+    });
+    for (auto& record : loaded) inventory.insert(std::move(record));
+}
+
+bool System::saveInventory() {
+    if (exportStrategy) {
+        bool saved = exportStrategy->exportInventory(inventory, INVENTORY_FILE);
+        if (snapshotStrategy && !snapshotStrategy->exportInventory(inventory, INVENTORY_SNAPSHOT)) saved = false;
+        if (saved) dirtyTables[static_cast<int>(DataTable::INVENTORY)] = false;
+        return saved;
+    } else {
+        cerr << "Error: No export strategy set for saving inventory.\n";
+        return false;
+    }
+}
+
+void System::loadAttendees() {
+    if (loadAttendeesSnapshot()) return;
+    string contents;
+    if (!readWholeFile(ATTENDEES_FILE, contents)) return;
+    markDirty(DataTable::ATTENDEES);
+    vector<Attendee> loaded = parseLinesInParallel<Attendee>(contents, [](string_view line, vector<Attendee>& out) {
+        out.push_back(Attendee::fromString(line));
+    });
+    for (const auto& record : loaded) allAttendees.insert(record);
+}
+
+bool System::saveAttendees() {
+    if (exportStrategy) {
+        bool saved = exportStrategy->exportAttendees(allAttendees, ATTENDEES_FILE);
+        if (snapshotStrategy && !snapshotStrategy->exportAttendees(allAttendees, ATTENDEES_SNAPSHOT)) saved = false;
+        if (saved) dirtyTables[static_cast<int>(DataTable::ATTENDEES)] = false;
+        return saved;
+    } else {
+        cerr << "Error: No export strategy set for saving attendees.\n";
+        return false;
     }
-    inFile.close();
 }
 
-void System::saveEvents() {
-    if (exportStrategy) {
-        exportStrategy->exportEvents(events, EVENTS_FILE, *this);
-    } else {
-        cerr << "Error: No export strategy set for saving events.\n";
+// A snapshot is used only if it is at least as new as its text file (which may have been
+// edited by hand) and its header and checksum check out
+bool System::openSnapshot(const MappedFile& file, const string& snapshotFile, const string& textFile,
+                          DataTable table, SnapshotReader& reader, uint32_t& recordCount) const {
+    if (!file.isOpen()) return false;
+    error_code ec;
+    auto textTime = filesystem::last_write_time(textFile, ec);
+    if (!ec && textTime > filesystem::last_write_time(snapshotFile, ec) && !ec) {
+        warningStream() << "Info: " << textFile << " is newer than " << snapshotFile << ". Loading the text file.\n";
+        return false;
+    }
+    if (!openSnapshotPayload(file, table, reader, recordCount)) {
+        warningStream() << "Warning: " << snapshotFile << " is damaged or from another version. Loading " << textFile << " instead.\n";
+        return false;
     }
+    return true;
 }
 
-void System::loadInventory() {
-    ifstream inFile(INVENTORY_FILE); if (!inFile) return;
-    string line;
-    while (getline(inFile, line)) {
-        if (!line.empty()) inventory.push_back(InventoryItem::fromString(line));
+bool System::loadUsersSnapshot() {
+    MappedFile file(USERS_SNAPSHOT);
+    SnapshotReader reader(nullptr, 0);
+    uint32_t count = 0;
+    if (!openSnapshot(file, USERS_SNAPSHOT, USERS_FILE, DataTable::USERS, reader, count)) return false;
+    vector<User*> loaded;
+    loaded.reserve(count);
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+        int id = reader.readInt();
+        Role role = static_cast<Role>(reader.readInt());
+        string_view uname = reader.readString();
+        string_view pwd = reader.readString();
+        if (!reader.ok()) break;
+        User* u = User::create(id, string(uname), string(pwd), role);
+        if (u) loaded.push_back(u);
+    }
+    if (!reader.ok() || !reader.atEnd()) {
+        for (User* u : loaded) delete u;
+        warningStream() << "Warning: " << USERS_SNAPSHOT << " has malformed records. Loading " << USERS_FILE << " instead.\n";
+        return false;
     }
-    inFile.close();
+    users.insert(users.end(), loaded.begin(), loaded.end());
+    return true;
 }
 
-void System::saveInventory() {
-    if (exportStrategy) {
-        exportStrategy->exportInventory(inventory, INVENTORY_FILE);
-    } else {
-        cerr << "Error: No export strategy set for saving inventory.\n";
+bool System::loadEventsSnapshot() {
+    MappedFile file(EVENTS_SNAPSHOT);
+    SnapshotReader reader(nullptr, 0);
+    uint32_t count = 0;
+    if (!openSnapshot(file, EVENTS_SNAPSHOT, EVENTS_FILE, DataTable::EVENTS, reader, count)) return false;
+    vector<InternedString> dictionary;
+    reader.readDictionary(dictionary);
+    vector<Event> loaded;
+    loaded.reserve(count);
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+        int id = reader.readInt();
+        int statusValue = reader.readInt();
+        string_view name = reader.readString();
+        PackedDate date = reader.readInt();
+        PackedTime time = static_cast<PackedTime>(reader.readInt());
+        string_view storedDate = reader.readString();
+        string_view storedTime = reader.readString();
+        InternedString loc = reader.readInterned(dictionary);
+        string_view desc = reader.readString();
+        InternedString cat = reader.readInterned(dictionary);
+        if (!reader.ok()) break;
+        if (statusValue < 0 || statusValue >= EVENT_STATUS_COUNT) {
+            warningStream() << "Warning: Invalid status " << statusValue << " for event " << id << " in " << EVENTS_SNAPSHOT << ". Loading it as Upcoming.\n";
+            statusValue = static_cast<int>(EventStatus::UPCOMING);
+        }
+        loaded.emplace_back(id, string(name), date, time, loc, string(desc), cat, static_cast<EventStatus>(statusValue));
+        Event& event = loaded.back();
+        event.details->storedDate = string(storedDate);
+        event.details->storedTime = string(storedTime);
+        vector<int> attendeeIds;
+        reader.readIntArray(attendeeIds);
+        event.details->attendeeIds.assign(std::move(attendeeIds));
+        int allocations = reader.readInt();
+        for (int j = 0; j < allocations && reader.ok(); ++j) {
+            int itemId = reader.readInt();
+            int quantity = reader.readInt();
+            event.details->allocatedInventory[itemId] = quantity;
+        }
+    }
+    if (!reader.ok() || !reader.atEnd()) {
+        warningStream() << "Warning: " << EVENTS_SNAPSHOT << " has malformed records. Loading " << EVENTS_FILE << " instead.\n";
+        return false;
     }
+    for (auto& record : loaded) events.insert(std::move(record));
+    return true;
 }
 
-void System::loadAttendees() {
-    ifstream inFile(ATTENDEES_FILE); if (!inFile) return;
-    string line;
-    while (getline(inFile, line)) {
-        if (!line.empty()) allAttendees.push_back(Attendee::fromString(line));
+bool System::loadInventorySnapshot() {
+    MappedFile file(INVENTORY_SNAPSHOT);
+    SnapshotReader reader(nullptr, 0);
+    uint32_t count = 0;
+    if (!openSnapshot(file, INVENTORY_SNAPSHOT, INVENTORY_FILE, DataTable::INVENTORY, reader, count)) return false;
+    vector<InternedString> dictionary;
+    reader.readDictionary(dictionary);
+    vector<InventoryItem> loaded;
+    loaded.reserve(count);
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+        int id = reader.readInt();
+        int totalQty = reader.readInt();
+        int allocQty = reader.readInt();
+        string_view name = reader.readString();
+        InternedString desc = reader.readInterned(dictionary);
+        if (!reader.ok()) break;
+        loaded.emplace_back(id, string(name), totalQty, allocQty, desc);
+    }
+    if (!reader.ok() || !reader.atEnd()) {
+        warningStream() << "Warning: " << INVENTORY_SNAPSHOT << " has malformed records. Loading " << INVENTORY_FILE << " instead.\n";
+        return false;
     }
-    inFile.close();
+    for (auto& record : loaded) inventory.insert(std::move(record));
+    return true;
 }
 
-void System::saveAttendees() {
-    if (exportStrategy) {
-        exportStrategy->exportAttendees(allAttendees, ATTENDEES_FILE);
-    } else {
-        cerr << "Error: No export strategy set for saving attendees.\n";
+bool System::loadAttendeesSnapshot() {
+    MappedFile file(ATTENDEES_SNAPSHOT);
+    SnapshotReader reader(nullptr, 0);
+    uint32_t count = 0;
+    if (!openSnapshot(file, ATTENDEES_SNAPSHOT, ATTENDEES_FILE, DataTable::ATTENDEES, reader, count)) return false;
+    vector<Attendee> loaded;
+    loaded.reserve(count);
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+        int id = reader.readInt();
+        int eventId = reader.readInt();
+        bool checkedIn = reader.readInt() != 0;
+        int ownerId = reader.readInt();
+        string_view name = reader.readString();
+        string_view contact = reader.readString();
+        if (!reader.ok()) break;
+        loaded.emplace_back(id, string(name), string(contact), eventId, checkedIn, ownerId);
+    }
+    if (!reader.ok() || !reader.atEnd()) {
+        warningStream() << "Warning: " << ATTENDEES_SNAPSHOT << " has malformed records. Loading " << ATTENDEES_FILE << " instead.\n";
+        return false;
     }
+    for (const auto& record : loaded) allAttendees.insert(record);
+    return true;
 }
 
 bool System::usernameExists(const string& uname) const {
-    for (const auto* user : users) if (user && user->getUsername() == uname) return true; //Polymorphism
-    return false;
+    return usersByName.count(uname) > 0;
 }
 void System::createUserAccount(const string& uname, const string& pwd, Role role) {
     User* newUser = nullptr;
@@ -1253,8 +4200,10 @@ void System::createUserAccount(const string& uname, const string& pwd, Role role
     }
     
     users.push_back(newUser);
+    indexUser(newUser);
     cout << (role == Role::ADMIN ? "Admin" : "User") << " account '" << uname << "' created (ID: " << newUser->getUserId() << ").\n";
-    saveUsers();
+    recordChange("USER+," + newUser->toString());
+    commitJournal();
 }
 // Update the username validation in publicRegisterNewUser
 void System::publicRegisterNewUser() {
@@ -1309,8 +4258,11 @@ void System::deleteUserAccount(const string& uname) {
         return;
     }
 
+    int deletedUserId = 0;
     auto it = remove_if(users.begin(), users.end(), [&](User* u) {
         if (u && u->getUsername() == uname) {
+            deletedUserId = u->getUserId();
+            unindexUser(u);
             delete u; // Deallocate the User object
             return true;
         }
@@ -1319,32 +4271,189 @@ void System::deleteUserAccount(const string& uname) {
     if (it != users.end()) {
         users.erase(it, users.end());
         cout << "User '" << uname << "' deleted.\n";
-        saveUsers();
+        recordChange("USER-," + to_string(deletedUserId));
+        commitJournal();
     }
     else { cout << "User '" << uname << "' not found.\n"; }
 }
 User* System::findUserByUsername(const string& uname) {
-    for (auto* user : users) if (user && user->getUsername() == uname) return user; return nullptr;
+    auto it = usersByName.find(uname);
+    return it == usersByName.end() ? nullptr : it->second;
 }
 const User* System::findUserByUsername(const string& uname) const {
-    for (const auto* user : users) if (user && user->getUsername() == uname) return user; return nullptr;
+    auto it = usersByName.find(uname);
+    return it == usersByName.end() ? nullptr : it->second;
+}
+void System::indexUser(User* user) {
+    // First account wins on duplicate names
+    if (user && usersByName.emplace(user->getUsername(), user).second) {
+        usernames.insert(user->getUsername(), user->getUserId());
+    }
+}
+void System::unindexUser(const User* user) {
+    auto it = usersByName.find(user->getUsername());
+    if (it != usersByName.end() && it->second == user) {
+        usersByName.erase(it);
+        usernames.remove(user->getUsername(), user->getUserId());
+    }
+}
+void System::rebuildUserIndex() {
+    usersByName.clear();
+    usernames.clear();
+    usersByName.reserve(users.size());
+    for (User* u : users) indexUser(u);
 }
 void System::listAllUsers() const {
     cout << "\n--- All Users ---\n"; if (users.empty()) { cout << "No users.\n"; return; }
     for (const auto* user : users) if (user) user->displayDetails(); // Using polymorphic displayDetails
 }
+vector<NameTrie::Completion> System::completeEventName(const string& prefix, size_t limit) const {
+    return eventNames.complete(prefix, limit);
+}
+vector<NameTrie::Completion> System::completeInventoryName(const string& prefix, size_t limit) const {
+    return inventoryNames.complete(prefix, limit);
+}
+vector<NameTrie::Completion> System::completeUsername(const string& prefix, size_t limit) const {
+    return usernames.complete(prefix, limit);
+}
+// Lists the completions of a "prefix?" entry; returns false if the input is not such a request
+static bool showCompletions(const string& input, const NameTrie& names, size_t limit) {
+    if (input.back() != '?') return false;
+    string prefix = input.substr(0, input.size() - 1);
+    vector<NameTrie::Completion> matches = names.complete(prefix, limit);
+    if (matches.empty()) {
+        cout << "No names start with '" << prefix << "'.\n";
+    }
+    for (const auto& match : matches) {
+        cout << "  " << setw(5) << match.id << "  " << match.name << "\n";
+    }
+    return true;
+}
+int System::getIdInputWithCompletion(const string& prompt, const NameTrie& names) const {
+    while (true) {
+        string input = getStringInput(prompt);
+        if (showCompletions(input, names, COMPLETION_LIMIT)) continue;
+        if (all_of(input.begin(), input.end(), [](unsigned char c) { return isdigit(c); })) {
+            int id = 0;
+            auto result = from_chars(input.data(), input.data() + input.size(), id);
+            if (result.ec == errc() && id > 0) return id;
+            cout << "Input must be a positive integer. Please try again.\n";
+            continue;
+        }
+        vector<NameTrie::Completion> exact = names.lookup(input);
+        if (exact.size() == 1) return exact.front().id;
+        if (exact.size() > 1) {
+            cout << "Several entries are named '" << input << "'. Please enter the ID:\n";
+            showCompletions(input + "?", names, COMPLETION_LIMIT);
+        } else {
+            cout << "Enter an ID or an exact name, or end a name prefix with '?' to list matches.\n";
+        }
+    }
+}
+int System::getEventIdInput(const string& prompt) const {
+    return getIdInputWithCompletion(prompt, eventNames);
+}
+int System::getInventoryItemIdInput(const string& prompt) const {
+    return getIdInputWithCompletion(prompt, inventoryNames);
+}
+string System::getUsernameInput(const string& prompt) const {
+    while (true) {
+        string input = getStringInput(prompt);
+        if (!showCompletions(input, usernames, COMPLETION_LIMIT)) return input;
+    }
+}
 bool System::login() {
     cout << "\n--- Login ---\n";
     string uname = getStringInput("Username: "); string pwd = getStringInput("Password: ");
-    for (User* u : users) if (u && u->getUsername() == uname && u->getPassword() == pwd) {
+    User* u = findUserByUsername(uname);
+    if (u && u->getPassword() == pwd) {
         currentUser = u; cout << "Login successful. Welcome, " << currentUser->getUsername() << "!\n"; return true;
     }
     cout << "Login failed. Invalid username or password.\n"; currentUser = nullptr; return false;
 }
 void System::logout() { if (currentUser) { cout << "Logging out " << currentUser->getUsername() << ".\n"; currentUser = nullptr; } }
 
-Event* System::findEventById(int eventId) { for (auto& event : events) if (event.eventId == eventId) return &event; return nullptr; }
-const Event* System::findEventById(int eventId) const { for (const auto& event : events) if (event.eventId == eventId) return &event; return nullptr; }
+Event* System::findEventById(int eventId) {
+    auto it = eventSlots.find(eventId);
+    return it == eventSlots.end() ? nullptr : events.get(it->second);
+}
+const Event* System::findEventById(int eventId) const {
+    auto it = eventSlots.find(eventId);
+    return it == eventSlots.end() ? nullptr : events.get(it->second);
+}
+
+Event& System::insertEvent(Event event) {
+    SlotMap<Event>::Handle handle = events.insert(std::move(event));
+    Event& added = *events.get(handle);
+    eventSlots.emplace(added.eventId, handle); // First record wins on duplicate ids
+    addToEventIndexes(added);
+    return added;
+}
+void System::eraseEventRecord(int eventId) {
+    auto it = eventSlots.find(eventId);
+    if (it == eventSlots.end()) return;
+    events.erase(it->second);
+    eventSlots.erase(it);
+    compactIfWorthwhile(events);
+}
+// Compacts once tombstones are both numerous and a quarter of the slots, so the cost of a
+// compaction is spread over the deletes that caused it
+template <typename Records>
+void System::compactIfWorthwhile(Records& records) {
+    size_t tombstones = records.tombstoneCount();
+    if (tombstones >= COMPACTION_MIN_TOMBSTONES && tombstones * 4 >= records.slotCount()) records.compact();
+}
+void System::compactStorage() {
+    events.compact();
+    allAttendees.compact();
+    inventory.compact();
+}
+vector<string> System::eventTextTokens(const Event& event) {
+    vector<string> tokens = InvertedIndex::tokenize(event.name);
+    const EventDetails& details = *event.details;
+    for (const string* field : { &details.description, &details.location.str(), &details.category.str() }) {
+        vector<string> more = InvertedIndex::tokenize(*field);
+        tokens.insert(tokens.end(), make_move_iterator(more.begin()), make_move_iterator(more.end()));
+    }
+    return tokens;
+}
+void System::addToEventIndexes(const Event& event) {
+    long long startKey = eventStartKey(event.date, event.time);
+    if (startKey >= 0) eventsByStart.emplace(startKey, event.eventId);
+    eventText.add(event.eventId, eventTextTokens(event));
+    eventTrigrams.add(event.eventId, { event.name, event.details->location, event.dateText() });
+    eventNames.insert(event.name, event.eventId);
+    int status = static_cast<int>(event.status);
+    if (status < EVENT_STATUS_COUNT) eventsByStatus[status].add(static_cast<uint32_t>(event.eventId));
+    eventsByCategory[event.details->category].add(static_cast<uint32_t>(event.eventId));
+}
+void System::removeFromEventIndexes(const Event& event) {
+    eventsByStart.erase({ eventStartKey(event.date, event.time), event.eventId });
+    eventText.remove(event.eventId, eventTextTokens(event));
+    eventTrigrams.remove(event.eventId);
+    eventNames.remove(event.name, event.eventId);
+    int status = static_cast<int>(event.status);
+    if (status < EVENT_STATUS_COUNT) eventsByStatus[status].remove(static_cast<uint32_t>(event.eventId));
+    auto category = eventsByCategory.find(event.details->category);
+    if (category != eventsByCategory.end()) {
+        category->second.remove(static_cast<uint32_t>(event.eventId));
+        if (category->second.empty()) eventsByCategory.erase(category);
+    }
+}
+void System::rebuildEventSearchIndexes() {
+    eventsByStart.clear();
+    eventText.clear();
+    eventTrigrams.clear();
+    eventNames.clear();
+    for (auto& bitmap : eventsByStatus) bitmap.clear();
+    eventsByCategory.clear();
+    for (const auto& event : events) addToEventIndexes(event);
+}
+void System::rebuildEventIndex() {
+    eventSlots.clear();
+    eventSlots.reserve(events.size());
+    for (auto it = events.begin(); it != events.end(); ++it) eventSlots.emplace(it->eventId, it.handle());
+}
 
 void System::createEvent() {
     cout << "\n--- Create Event ---\n";
@@ -1356,31 +4465,406 @@ void System::createEvent() {
         cout << "Invalid time format. Please use 24-hour format (00:00 to 24:00).\n"; 
     }
     string loc = getStringInput("Location: "); string desc = getStringInput("Description: "); string cat = getStringInput("Category: ");
-    events.emplace_back(name, date, time, loc, desc, cat);
-    cout << "Event '" << name << "' created (ID: " << events.back().eventId << ").\n"; saveEvents();
+    const Event& created = insertEvent(Event(name, parseDate(date), parseTime(time), InternedString(loc), desc, InternedString(cat)));
+    cout << "Event '" << name << "' created (ID: " << created.eventId << ").\n";
+    recordChange("EVENT+," + created.headerToString());
+    commitJournal();
 }
 void System::viewAllEvents(bool adminView) const {
     cout << "\n--- All Events ---\n"; if (events.empty()) { cout << "No events.\n"; return; }
     for (const auto& event : events) { event.displayDetails(*this); cout << "-------------------\n"; }
 }
+vector<const Event*> System::findEventsContaining(const string& text) const {
+    vector<const Event*> found;
+    for (int eventId : eventTrigrams.findSubstring(text)) {
+        const Event* event = findEventById(eventId);
+        if (event) found.push_back(event);
+    }
+    return found;
+}
+vector<const Event*> System::findEventsSimilarTo(const string& text) const {
+    vector<const Event*> found;
+    for (const auto& result : eventTrigrams.findSimilar(text, FUZZY_MATCH_THRESHOLD)) {
+        const Event* event = findEventById(result.first);
+        if (event) found.push_back(event);
+    }
+    return found;
+}
+vector<const Event*> System::scanEventDescriptions(const string& text, ScanStats& stats) const {
+    string needle = toLower(text);
+    vector<const Event*> found;
+    for (size_t pos : parallelScan(events, [&](const Event& event) { return containsIgnoreCase(event.details->description, needle); }, stats)) {
+        found.push_back(events.atSlot(pos));
+    }
+    return found;
+}
+void System::searchEventDescriptions() const {
+    string text = getStringInput("Enter text to find in event descriptions: ");
+    ScanStats stats;
+    vector<const Event*> found = scanEventDescriptions(text, stats);
+    cout << "\n--- Events Whose Description Contains '" << text << "' ---\n";
+    for (const Event* event : found) { event->displayDetails(*this); cout << "-------------------\n"; }
+    if (found.empty()) cout << "No events found.\n";
+    printScanStats(stats, found.size());
+}
+const RoaringBitmap& System::eventIdsWithStatus(EventStatus status) const {
+    static const RoaringBitmap noEvents;
+    int index = static_cast<int>(status);
+    return index < EVENT_STATUS_COUNT ? eventsByStatus[index] : noEvents;
+}
+const RoaringBitmap& System::eventIdsInCategory(const string& category) const {
+    static const RoaringBitmap noEvents;
+    auto it = eventsByCategory.find(category);
+    return it == eventsByCategory.end() ? noEvents : it->second;
+}
+void System::viewEventStatusCategoryCounts() const {
+    const EventStatus statuses[] = { EventStatus::UPCOMING, EventStatus::ONGOING, EventStatus::COMPLETED, EventStatus::CANCELED };
+    const char* statusNames[] = { "Upcoming", "Ongoing", "Completed", "Canceled" };
+    map<string, const RoaringBitmap*> categories; // Alphabetical for display
+    for (const auto& entry : eventsByCategory) categories.emplace(entry.first, &entry.second);
+
+    cout << "\n--- Events by Status and Category ---\n";
+    cout << left << setw(20) << "Category";
+    for (const char* name : statusNames) cout << right << setw(11) << name;
+    cout << right << setw(8) << "Total" << "\n";
+    for (const auto& category : categories) {
+        cout << left << setw(20) << category.first;
+        for (EventStatus status : statuses) {
+            cout << right << setw(11) << RoaringBitmap::intersectCardinality(*category.second, eventIdsWithStatus(status));
+        }
+        cout << right << setw(8) << category.second->cardinality() << "\n";
+    }
+    cout << left << setw(20) << "All categories";
+    for (EventStatus status : statuses) cout << right << setw(11) << eventIdsWithStatus(status).cardinality();
+    cout << right << setw(8) << events.size() << "\n";
+}
+string System::queryEvents(const QueryPredicate& where, const QueryOptions& options, const function<void(const Event&)>& onRow) const {
+    // Narrow the candidates with whichever index a required leaf allows gives the fewest:
+    // an id match, the smallest status/category bitmap, the events in the date range (counted
+    // only up to the best so far) or the shortest posting list of a text leaf's trigrams
+    const QueryPredicate* byId = nullptr;
+    const QueryPredicate* byDate = nullptr;
+    vector<const QueryPredicate*> byText;
+    vector<const QueryPredicate*> byBitmap; // Status and category equalities
+    for (const QueryPredicate* leaf : where.requiredLeaves()) {
+        if (leaf->kind == QueryPredicate::Kind::BETWEEN && leaf->field == QueryField::ID && leaf->low == leaf->high) {
+            byId = leaf;
+        } else if ((leaf->kind == QueryPredicate::Kind::BETWEEN && leaf->field == QueryField::STATUS && leaf->low == leaf->high) ||
+                   (leaf->kind == QueryPredicate::Kind::EQUALS && leaf->field == QueryField::CATEGORY)) {
+            byBitmap.push_back(leaf);
+        } else if (leaf->kind == QueryPredicate::Kind::BETWEEN && leaf->field == QueryField::DATE) {
+            byDate = leaf;
+        } else if (leaf->kind != QueryPredicate::Kind::BETWEEN && leaf->text.size() >= 3 &&
+                   (leaf->field == QueryField::NAME || leaf->field == QueryField::LOCATION)) {
+            byText.push_back(leaf);
+        }
+    }
+
+    static const RoaringBitmap noEvents;
+    auto bitmapOf = [&](const QueryPredicate* leaf) -> const RoaringBitmap& {
+        if (leaf->field != QueryField::STATUS) return eventIdsInCategory(leaf->text);
+        return (leaf->low >= 0 && leaf->low < EVENT_STATUS_COUNT) ? eventIdsWithStatus(static_cast<EventStatus>(leaf->low)) : noEvents;
+    };
+    long long fromKey = 0, toKey = -1; // An empty range unless byDate covers real days
+    if (byDate) {
+        long long fromDay = max(byDate->low, 0LL);
+        long long toDay = min(byDate->high, static_cast<long long>(LAST_DATE));
+        if (fromDay <= toDay) {
+            fromKey = eventStartKey(static_cast<PackedDate>(fromDay), 0);
+            toKey = eventStartKey(static_cast<PackedDate>(toDay), MINUTES_PER_DAY);
+        }
+    }
+
+    enum class IndexPath { NONE, ID, BITMAP, DATE, TRIGRAM };
+    IndexPath path = IndexPath::NONE;
+    size_t estimate = numeric_limits<size_t>::max();
+    const QueryPredicate* textLeaf = nullptr;
+    auto consider = [&](IndexPath candidate, size_t size) {
+        if (size < estimate) { path = candidate; estimate = size; }
+    };
+    if (byId) consider(IndexPath::ID, 1);
+    if (!byBitmap.empty()) {
+        size_t smallest = numeric_limits<size_t>::max(); // The intersection is no larger than any one bitmap
+        for (const QueryPredicate* leaf : byBitmap) smallest = min(smallest, static_cast<size_t>(bitmapOf(leaf).cardinality()));
+        consider(IndexPath::BITMAP, smallest);
+    }
+    if (byDate) {
+        size_t inRange = 0;
+        for (auto it = eventsByStart.lower_bound({ fromKey, numeric_limits<int>::min() });
+             it != eventsByStart.end() && it->first <= toKey && inRange < estimate; ++it) {
+            ++inRange;
+        }
+        consider(IndexPath::DATE, inRange);
+    }
+    for (const QueryPredicate* leaf : byText) {
+        size_t bound = eventTrigrams.substringCandidateBound(leaf->text);
+        if (bound < estimate) textLeaf = leaf;
+        consider(IndexPath::TRIGRAM, bound);
+    }
+
+    vector<const Event*> rows;
+    string plan;
+    if (path != IndexPath::NONE) {
+        vector<const Event*> candidates;
+        if (path == IndexPath::ID) {
+            plan = "event id index";
+            const Event* event = (byId->low > 0 && byId->low <= numeric_limits<int>::max()) ? findEventById(static_cast<int>(byId->low)) : nullptr;
+            if (event) candidates.push_back(event);
+        } else if (path == IndexPath::BITMAP) {
+            plan = "status/category bitmaps";
+            // A single bitmap is read in place; only a real intersection builds a new one
+            const RoaringBitmap* ids = &bitmapOf(byBitmap[0]);
+            RoaringBitmap intersection;
+            for (size_t i = 1; i < byBitmap.size(); ++i) {
+                intersection = RoaringBitmap::intersect(*ids, bitmapOf(byBitmap[i]));
+                ids = &intersection;
+            }
+            ids->forEach([&](uint32_t eventId) {
+                const Event* event = findEventById(static_cast<int>(eventId));
+                if (event) candidates.push_back(event);
+            });
+        } else if (path == IndexPath::DATE) {
+            plan = "date index";
+            for (auto it = eventsByStart.lower_bound({ fromKey, numeric_limits<int>::min() });
+                 it != eventsByStart.end() && it->first <= toKey; ++it) {
+                const Event* event = findEventById(it->second);
+                if (event) candidates.push_back(event);
+            }
+        } else {
+            plan = "trigram index";
+            for (int eventId : eventTrigrams.findSubstring(textLeaf->text)) {
+                const Event* event = findEventById(eventId);
+                if (event) candidates.push_back(event);
+            }
+        }
+        plan += ", " + to_string(candidates.size()) + " candidate(s) checked";
+        for (const Event* event : candidates) {
+            if (where.matches(*event)) rows.push_back(event);
+        }
+    } else {
+        ScanStats stats;
+        for (size_t pos : parallelScan(events, [&](const Event& event) { return where.matches(event); }, stats)) {
+            rows.push_back(events.atSlot(pos));
+        }
+        plan = "scan of " + to_string(stats.recordsScanned) + " event(s) on " + to_string(stats.threadsUsed) + " thread(s)";
+    }
+    orderQueryResults(rows, options);
+    for (const Event* event : rows) onRow(*event);
+    return plan;
+}
+string System::queryAttendees(const QueryPredicate& where, const QueryOptions& options, const function<void(const AttendeeView&)>& onRow) const {
+    const QueryPredicate* byId = nullptr;
+    const QueryPredicate* byEvent = nullptr;
+    for (const QueryPredicate* leaf : where.requiredLeaves()) {
+        if (leaf->kind != QueryPredicate::Kind::BETWEEN || leaf->low != leaf->high) continue;
+        if (leaf->field == QueryField::ID) byId = leaf;
+        if (leaf->field == QueryField::EVENT_ID) byEvent = leaf;
+    }
+
+    vector<AttendeeView> rows;
+    string plan;
+    if (byId || byEvent) {
+        vector<AttendeeView> candidates;
+        const QueryPredicate* leaf = byId ? byId : byEvent;
+        int id = (leaf->low >= numeric_limits<int>::min() && leaf->low <= numeric_limits<int>::max()) ? static_cast<int>(leaf->low) : -1;
+        if (byId) {
+            plan = "attendee id index";
+            AttendeeView att = findAttendeeInMasterList(id);
+            if (att) candidates.push_back(att);
+        } else {
+            plan = "event registrations index";
+            auto registered = registrationsByEvent.find(id);
+            if (registered != registrationsByEvent.end()) {
+                for (int attId : registered->second) {
+                    AttendeeView att = findAttendeeInMasterList(attId);
+                    if (att) candidates.push_back(att);
+                }
+            }
+        }
+        plan += ", " + to_string(candidates.size()) + " candidate(s) checked";
+        for (const AttendeeView& att : candidates) {
+            if (where.matches(att)) rows.push_back(att);
+        }
+    } else {
+        ScanStats stats;
+        for (size_t pos : parallelScan(allAttendees, [&](const AttendeeView& att) { return where.matches(att); }, stats)) {
+            rows.push_back(allAttendees.atSlot(pos));
+        }
+        plan = "scan of " + to_string(stats.recordsScanned) + " attendee record(s) on " + to_string(stats.threadsUsed) + " thread(s)";
+    }
+    orderQueryResults(rows, options);
+    for (const AttendeeView& att : rows) onRow(att);
+    return plan;
+}
+// Reads a YYYY-MM-DD date and returns it as a PackedDate
+static long long getDateNumberInput(const string& prompt) {
+    while (true) {
+        PackedDate date = parseDate(getStringInput(prompt));
+        if (date != INVALID_DATE) return date;
+        cout << "Invalid date format. Please try again.\n";
+    }
+}
+void System::runEventQuery() const {
+    cout << "\n--- Query Events ---\n";
+    vector<QueryPredicate> conditions;
+    int choice;
+    do {
+        cout << "Add a condition (events must match all of them):\n";
+        cout << "1. Name contains\n";
+        cout << "2. Location contains\n";
+        cout << "3. Category is\n";
+        cout << "4. Description contains\n";
+        cout << "5. Status is\n";
+        cout << "6. Date range\n";
+        cout << "7. Attendee count range\n";
+        cout << "0. Run query\n";
+        choice = getIntInput("Enter your choice: ");
+        switch (choice) {
+            case 1: conditions.push_back(QueryPredicate::contains(QueryField::NAME, getStringInput("Name contains: "))); break;
+            case 2: conditions.push_back(QueryPredicate::contains(QueryField::LOCATION, getStringInput("Location contains: "))); break;
+            case 3: conditions.push_back(QueryPredicate::equals(QueryField::CATEGORY, getStringInput("Category: "))); break;
+            case 4: conditions.push_back(QueryPredicate::contains(QueryField::DESCRIPTION, getStringInput("Description contains: "))); break;
+            case 5: {
+                cout << "1. Upcoming\n";
+                cout << "2. Ongoing\n";
+                cout << "3. Completed\n";
+                cout << "4. Canceled\n";
+                int status = getIntInput("Enter your choice: ");
+                if (status < 1 || status > 4) { cout << "Invalid status choice.\n"; break; }
+                conditions.push_back(QueryPredicate::equals(QueryField::STATUS, status - 1));
+                break;
+            }
+            case 6: {
+                long long from = getDateNumberInput("From date (YYYY-MM-DD): ");
+                long long to = getDateNumberInput("To date (YYYY-MM-DD): ");
+                if (to < from) swap(from, to);
+                conditions.push_back(QueryPredicate::between(QueryField::DATE, from, to));
+                break;
+            }
+            case 7: {
+                int low = getIntInput("Minimum attendees: ");
+                int high = getIntInput("Maximum attendees: ");
+                if (high < low) swap(low, high);
+                conditions.push_back(QueryPredicate::between(QueryField::ATTENDEE_COUNT, low, high));
+                break;
+            }
+            case 0: break;
+            default: cout << "Invalid choice. Please try again.\n"; break;
+        }
+    } while (choice != 0);
+
+    QueryOptions options;
+    cout << "Sort by: 1. ID  2. Name  3. Date  4. Attendee count\n";
+    switch (getIntInput("Enter your choice: ")) {
+        case 2: options.orderBy = QueryField::NAME; break;
+        case 3: options.orderBy = QueryField::DATE; break;
+        case 4: options.orderBy = QueryField::ATTENDEE_COUNT; break;
+        default: options.orderBy = QueryField::ID; break;
+    }
+    options.descending = getIntInput("Order: 1. Ascending  2. Descending: ") == 2;
+    options.limit = static_cast<size_t>(max(0, getIntInput("Maximum results (0 for all): ")));
+
+    cout << "\n--- Query Results ---\n";
+    size_t count = 0;
+    string plan = queryEvents(QueryPredicate::allOf(std::move(conditions)), options, [&](const Event& event) {
+        event.displayDetails(*this);
+        cout << "-------------------\n";
+        ++count;
+    });
+    if (count == 0) cout << "No events match.\n";
+    cout << count << " result(s); plan: " << plan << ".\n";
+}
 void System::searchEventsByNameOrDate() const {
-    string searchTerm = toLower(getStringInput("Enter event name or date to search: "));
-    bool found = false;
+    string searchTerm = toLower(getStringInput("Enter event name, location or date to search: "));
     cout << "\n--- Search Results ---\n";
-    for (const auto& event : events) {
-        if (toLower(event.name).find(searchTerm) != string::npos ||
-            event.date.find(searchTerm) != string::npos) {
-            event.displayDetails(*this);
-            cout << "-------------------\n";
-            found = true;
+    vector<const Event*> found = findEventsContaining(searchTerm);
+    if (found.empty()) {
+        found = findEventsSimilarTo(searchTerm);
+        if (found.empty()) {
+            cout << "No events found matching '" << searchTerm << "'.\n";
+            return;
         }
+        cout << "No exact match for '" << searchTerm << "'. Did you mean:\n";
+    }
+    for (const Event* event : found) { event->displayDetails(*this); cout << "-------------------\n"; }
+}
+vector<const Event*> System::findEventsInDateRange(const string& fromDate, const string& toDate) const {
+    vector<const Event*> found;
+    long long fromKey = eventStartKey(parseDate(fromDate), 0);
+    long long toKey = eventStartKey(parseDate(toDate), MINUTES_PER_DAY);
+    if (fromKey < 0 || toKey < 0) return found;
+    // O(log n) to the first event in range, then one step per match
+    for (auto it = eventsByStart.lower_bound({ fromKey, numeric_limits<int>::min() });
+         it != eventsByStart.end() && it->first <= toKey; ++it) {
+        const Event* event = findEventById(it->second);
+        if (event) found.push_back(event);
+    }
+    return found;
+}
+vector<const Event*> System::findNextUpcomingEvents(size_t count) const {
+    vector<const Event*> found;
+    time_t now = std::time(nullptr);
+    tm local = *localtime(&now);
+    long long nowKey = eventStartKey(makeDate(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday), local.tm_hour * 60 + local.tm_min);
+    for (auto it = eventsByStart.lower_bound({ nowKey, numeric_limits<int>::min() });
+         it != eventsByStart.end() && found.size() < count; ++it) {
+        const Event* event = findEventById(it->second);
+        if (event && event->status != EventStatus::CANCELED && event->status != EventStatus::COMPLETED) {
+            found.push_back(event);
+        }
+    }
+    return found;
+}
+vector<const Event*> System::searchEventsByKeywords(const string& query, bool matchAll) const {
+    vector<const Event*> found;
+    for (const auto& result : eventText.search(query, matchAll)) {
+        const Event* event = findEventById(result.first);
+        if (event) found.push_back(event);
+    }
+    return found;
+}
+void System::keywordSearchEvents() const {
+    string query = getStringInput("Enter keywords (name, description, location, category): ");
+    cout << "1. Match all words\n";
+    cout << "2. Match any word\n";
+    int mode = getIntInput("Enter your choice: ");
+    if (mode != 1 && mode != 2) {
+        cout << "Invalid choice. Please enter 1 or 2.\n";
+        return;
+    }
+    vector<const Event*> found = searchEventsByKeywords(query, mode == 1);
+    cout << "\n--- Keyword Search Results (best match first) ---\n";
+    if (found.empty()) {
+        cout << "No events found matching '" << query << "'.\n";
+        return;
     }
-    if (!found) {
-        cout << "No events found matching '" << searchTerm << "'.\n";
+    for (const Event* event : found) { event->displayDetails(*this); cout << "-------------------\n"; }
+}
+void System::searchEventsByDateRange() const {
+    string fromDate, toDate;
+    while(true){ fromDate = getStringInput("From date (YYYY-MM-DD): "); if(isValidDate(fromDate)) break; cout << "Invalid date format. Please try again.\n"; }
+    while(true){ toDate = getStringInput("To date (YYYY-MM-DD): "); if(isValidDate(toDate)) break; cout << "Invalid date format. Please try again.\n"; }
+    if (toDate < fromDate) swap(fromDate, toDate);
+    vector<const Event*> found = findEventsInDateRange(fromDate, toDate);
+    cout << "\n--- Events from " << fromDate << " to " << toDate << " ---\n";
+    if (found.empty()) {
+        cout << "No events in this date range.\n";
+        return;
+    }
+    for (const Event* event : found) { event->displayDetails(*this); cout << "-------------------\n"; }
+}
+void System::viewNextUpcomingEvents() const {
+    int count = getPositiveIntInput("How many upcoming events to show: ");
+    vector<const Event*> found = findNextUpcomingEvents(static_cast<size_t>(count));
+    cout << "\n--- Next Upcoming Events ---\n";
+    if (found.empty()) {
+        cout << "No upcoming events.\n";
+        return;
     }
+    for (const Event* event : found) { event->displayDetails(*this); cout << "-------------------\n"; }
 }
 void System::editEventDetails() {
-    int eventId = getPositiveIntInput("Enter Event ID to edit: ");
+    int eventId = getEventIdInput("Enter Event ID to edit: ");
     Event* event = findEventById(eventId);
     if (!event) {
         cout << "Event with ID " << eventId << " not found.\n";
@@ -1397,55 +4881,59 @@ void System::editEventDetails() {
     cout << "7. Back\n";
 
     int choice = getIntInput("Enter your choice: ");
+    if (choice < 1 || choice > 6) {
+        if (choice != 7) cout << "Invalid choice. No changes made.\n";
+        return;
+    }
     string new_val;
+    removeFromEventIndexes(*event); // Re-added below with the new values
     switch (choice) {
         case 1: new_val = getStringInput("Enter new name: "); event->name = new_val; break;
         case 2:
             while(true){ new_val = getStringInput("Enter new date (YYYY-MM-DD): "); if(isValidDate(new_val)) break; cout << "Invalid date format or value. Please try again.\n"; }
-            event->date = new_val;
+            event->date = parseDate(new_val);
             break;
         case 3:
             while(true){ new_val = getStringInput("Enter new time (HH:MM): "); if(isValidTime(new_val)) break; cout << "Invalid time format or value. Please try again.\n"; }
-            event->time = new_val;
+            event->time = parseTime(new_val);
             break;
-        case 4: new_val = getStringInput("Enter new location: "); event->location = new_val; break;
-        case 5: new_val = getStringInput("Enter new description: "); event->description = new_val; break;
-        case 6: new_val = getStringInput("Enter new category: "); event->category = new_val; break;
-        case 7: return;
-        default: cout << "Invalid choice. No changes made.\n"; return;
+        case 4: new_val = getStringInput("Enter new location: "); event->details->location = InternedString(new_val); break;
+        case 5: new_val = getStringInput("Enter new description: "); event->details->description = new_val; break;
+        case 6: new_val = getStringInput("Enter new category: "); event->details->category = InternedString(new_val); break;
     }
+    addToEventIndexes(*event);
     cout << "Event details updated successfully.\n";
-    saveEvents();
+    recordChange("EVENT+," + event->headerToString());
+    commitJournal();
 }
 void System::deleteEvent() {
-    int eventId = getPositiveIntInput("Enter Event ID to delete: ");
-    auto it = remove_if(events.begin(), events.end(), [&](const Event& e) {
-        return e.eventId == eventId;
-    });
+    int eventId = getEventIdInput("Enter Event ID to delete: ");
+    Event* event = findEventById(eventId);
+    if (!event) {
+        cout << "Event with ID " << eventId << " not found.\n";
+        return;
+    }
 
-    if (it != events.end()) {
-        // Deallocate any inventory allocated to this event
-        for(const auto& pair : it->allocatedInventory) {
-            InventoryItem* item = findInventoryItemById(pair.first);
-            if(item) {
-                item->deallocate(pair.second); // Return allocated items to general pool
-            }
+    // Deallocate any inventory allocated to this event
+    for(const auto& pair : event->details->allocatedInventory) {
+        InventoryItem* item = findInventoryItemById(pair.first);
+        if(item) {
+            item->deallocate(pair.second); // Return allocated items to general pool
         }
-        // Remove attendees registered for this event
-        allAttendees.erase(remove_if(allAttendees.begin(), allAttendees.end(),
-            [&](const Attendee& att){ return att.eventIdRegisteredFor == eventId; }), allAttendees.end());
-
-        cout << "Event '" << it->name << "' (ID: " << it->eventId << ") and its associated registrations deleted.\n";
-        events.erase(it, events.end());
-        saveEvents();
-        saveInventory(); // Save inventory changes
-        saveAttendees(); // Save attendees changes
-    } else {
-        cout << "Event with ID " << eventId << " not found.\n";
     }
+    removeFromEventIndexes(*event);
+    string eventName = event->name;
+
+    // Remove attendees registered for this event, then the event itself
+    eraseAttendeesOfEvent(eventId);
+    eraseEventRecord(eventId);
+
+    cout << "Event '" << eventName << "' (ID: " << eventId << ") and its associated registrations deleted.\n";
+    recordChange("EVENT-," + to_string(eventId)); // Replay repeats the cascade
+    commitJournal();
 }
 void System::updateEventStatus() {
-    int eventId = getPositiveIntInput("Enter Event ID to update status: ");
+    int eventId = getEventIdInput("Enter Event ID to update status: ");
     Event* event = findEventById(eventId);
     if (!event) {
         cout << "Event with ID " << eventId << " not found.\n";
@@ -1458,28 +4946,110 @@ void System::updateEventStatus() {
     cout << "3. Completed\n";
     cout << "4. Canceled\n";
     int choice = getIntInput("Enter your choice: ");
+    if (choice < 1 || choice > 4) {
+        cout << "Invalid status choice. Status not updated.\n";
+        return;
+    }
+    removeFromEventIndexes(*event);
     switch (choice) {
         case 1: event->status = EventStatus::UPCOMING; break;
         case 2: event->status = EventStatus::ONGOING; break;
         case 3: event->status = EventStatus::COMPLETED; break;
         case 4: event->status = EventStatus::CANCELED; break;
-        default: cout << "Invalid status choice. Status not updated.\n"; return;
     }
+    addToEventIndexes(*event);
     cout << "Status updated to " << event->getStatusString() << ".\n";
-    saveEvents();
+    recordChange("EVENT+," + event->headerToString());
+    commitJournal();
+}
+
+AttendeeRef System::findAttendeeInMasterList(int attendeeId) {
+    auto it = attendeeSlots.find(attendeeId);
+    return it == attendeeSlots.end() ? AttendeeRef() : allAttendees.get(it->second);
+}
+AttendeeView System::findAttendeeInMasterList(int attendeeId) const {
+    auto it = attendeeSlots.find(attendeeId);
+    return it == attendeeSlots.end() ? AttendeeView() : allAttendees.get(it->second);
 }
 
-Attendee* System::findAttendeeInMasterList(int attendeeId) {
-    for (auto& att : allAttendees) {
-        if (att.attendeeId == attendeeId) return &att;
+AttendeeRef System::insertAttendee(const Attendee& attendee) {
+    AttendeeStore::Handle handle = allAttendees.insert(attendee);
+    attendeeSlots.emplace(attendee.attendeeId, handle);
+    indexRegistration(attendee.attendeeId, attendee.eventIdRegisteredFor, attendee.userId);
+    return allAttendees.get(handle);
+}
+void System::eraseAttendeeRecord(int attendeeId) {
+    auto it = attendeeSlots.find(attendeeId);
+    if (it == attendeeSlots.end()) return;
+    AttendeeView att = allAttendees.get(it->second);
+    if (att) unindexRegistration(attendeeId, att.eventIdRegisteredFor(), att.userId());
+    allAttendees.erase(it->second);
+    attendeeSlots.erase(it);
+    compactIfWorthwhile(allAttendees);
+}
+void System::eraseAttendeesOfEvent(int eventId) {
+    auto registered = registrationsByEvent.find(eventId);
+    if (registered == registrationsByEvent.end()) return;
+    AttendeeSet attendeeIds = move(registered->second);
+    registrationsByEvent.erase(registered); // So each eraseAttendeeRecord finds nothing to unindex
+    for (int attId : attendeeIds) eraseAttendeeRecord(attId);
+}
+void System::rebuildAttendeeIndex() {
+    attendeeSlots.clear();
+    registrationsByUser.clear();
+    registrationsByEvent.clear();
+    attendeeSlots.reserve(allAttendees.size());
+    for (auto it = allAttendees.begin(); it != allAttendees.end(); ++it) {
+        attendeeSlots.emplace(it->attendeeId(), it.handle());
+        indexRegistration(it->attendeeId(), it->eventIdRegisteredFor(), it->userId());
     }
-    return nullptr;
 }
-const Attendee* System::findAttendeeInMasterList(int attendeeId) const {
-    for (const auto& att : allAttendees) {
-        if (att.attendeeId == attendeeId) return &att;
+static void removeRegistrationId(unordered_map<int, vector<int>>& index, int key, int attendeeId) {
+    auto owned = index.find(key);
+    if (owned == index.end()) return;
+    vector<int>& ids = owned->second;
+    ids.erase(remove(ids.begin(), ids.end(), attendeeId), ids.end());
+    if (ids.empty()) index.erase(owned);
+}
+void System::indexRegistration(int attendeeId, int eventId, int userId) {
+    if (userId != 0) registrationsByUser[userId].push_back(attendeeId);
+    registrationsByEvent[eventId].insert(attendeeId);
+}
+void System::unindexRegistration(int attendeeId, int eventId, int userId) {
+    removeRegistrationId(registrationsByUser, userId, attendeeId);
+    auto registered = registrationsByEvent.find(eventId);
+    if (registered == registrationsByEvent.end()) return;
+    registered->second.erase(attendeeId);
+    if (registered->second.empty()) registrationsByEvent.erase(registered);
+}
+vector<AttendeeRef> System::findRegistrationsOfUser(int userId) {
+    vector<AttendeeRef> registrations;
+    auto it = registrationsByUser.find(userId);
+    if (it == registrationsByUser.end()) return registrations;
+    for (int attId : it->second) {
+        AttendeeRef att = findAttendeeInMasterList(attId);
+        if (att && att.userId() == userId) registrations.push_back(att);
+    }
+    return registrations;
+}
+void System::resolveAttendeeOwners() {
+    unordered_map<string, int, CaseInsensitiveHash, CaseInsensitiveEqual> userIdsByName;
+    for (const User* u : users) {
+        if (u) userIdsByName.emplace(u->getUsername(), u->getUserId());
+    }
+    bool resolved = false;
+    for (AttendeeRef att : allAttendees) {
+        if (att.userId() != 0) continue;
+        auto it = userIdsByName.find(string(att.name()));
+        if (it != userIdsByName.end()) {
+            att.setUserId(it->second);
+            resolved = true;
+        }
+    }
+    if (resolved) {
+        markDirty(DataTable::ATTENDEES); // Rewrite the file with the user ids filled in
+        rebuildAttendeeIndex();
     }
-    return nullptr;
 }
 
 void System::registerAttendeeForEvent() {
@@ -1488,7 +5058,7 @@ void System::registerAttendeeForEvent() {
         return;
     }
 
-    int eventId = getPositiveIntInput("Enter Event ID to register for: ");
+    int eventId = getEventIdInput("Enter Event ID to register for: ");
     Event* event = findEventById(eventId);
     if (!event) {
         cout << "Event with ID " << eventId << " not found.\n";
@@ -1507,19 +5077,21 @@ void System::registerAttendeeForEvent() {
     string contact = getStringInput("Enter your contact info (email/phone): ");
 
     // Find if the user already has an attendee profile created for this event
-    Attendee* existingAttendee = nullptr;
-    for (auto& att : allAttendees) {
-        if (toLower(att.name) == toLower(attendeeName) && att.eventIdRegisteredFor == eventId) {
-            existingAttendee = &att;
+    // (only this user's own records are looked at, through registrationsByUser)
+    vector<AttendeeRef> ownRecords = findRegistrationsOfUser(currentUser->getUserId());
+    AttendeeRef existingAttendee;
+    for (const AttendeeRef& att : ownRecords) {
+        if (att.eventIdRegisteredFor() == eventId) {
+            existingAttendee = att;
             break;
         }
     }
      // Or, perhaps a user might have a generic attendee profile.
     if (!existingAttendee) {
-        for (auto& att : allAttendees) {
-            if (toLower(att.name) == toLower(attendeeName) && att.eventIdRegisteredFor == 0) { // Event ID 0 for generic profile
-                existingAttendee = &att;
-                existingAttendee->contactInfo = contact; // Update contact if changed
+        for (const AttendeeRef& att : ownRecords) {
+            if (att.eventIdRegisteredFor() == 0) { // Event ID 0 for generic profile
+                existingAttendee = att;
+                existingAttendee.setContactInfo(contact); // Update contact if changed
                 break;
             }
         }
@@ -1528,17 +5100,20 @@ void System::registerAttendeeForEvent() {
 
     if (existingAttendee) {
         // If an attendee profile exists for the user and this event, just ensure they are registered
-        event->addAttendee(existingAttendee->attendeeId);
+        event->addAttendee(existingAttendee.attendeeId());
+        recordChange("ATTENDEE+," + existingAttendee.toString());
+        recordChange("REG+," + to_string(eventId) + "," + to_string(existingAttendee.attendeeId()));
         cout << "You are already associated with an attendee profile. Registration confirmed for event '" << event->name << "'.\n";
     } else {
         // Create a new attendee record for this specific registration
-        Attendee newAttendee(attendeeName, contact, eventId);
-        allAttendees.push_back(newAttendee);
+        Attendee newAttendee(attendeeName, contact, eventId, currentUser->getUserId());
+        insertAttendee(newAttendee);
         event->addAttendee(newAttendee.attendeeId);
+        recordChange("ATTENDEE+," + newAttendee.toString());
+        recordChange("REG+," + to_string(eventId) + "," + to_string(newAttendee.attendeeId));
         cout << "Registered as new attendee '" << newAttendee.name << "' (ID: " << newAttendee.attendeeId << ") for event '" << event->name << "'.\n";
     }
-    saveEvents();
-    saveAttendees();
+    commitJournal();
 }
 
 
@@ -1548,7 +5123,7 @@ void System::cancelOwnRegistration() {
         return;
     }
 
-    int eventId = getPositiveIntInput("Enter Event ID to cancel registration for: ");
+    int eventId = getEventIdInput("Enter Event ID to cancel registration for: ");
     Event* event = findEventById(eventId);
     if (!event) {
         cout << "Event with ID " << eventId << " not found.\n";
@@ -1557,9 +5132,9 @@ void System::cancelOwnRegistration() {
 
     // Find the attendee ID corresponding to the current user and this event
     int attendeeIdToCancel = -1;
-    for (const auto& att : allAttendees) {
-        if (toLower(att.name) == toLower(currentUser->getUsername()) && att.eventIdRegisteredFor == eventId) {
-            attendeeIdToCancel = att.attendeeId;
+    for (const AttendeeRef& att : findRegistrationsOfUser(currentUser->getUserId())) {
+        if (att.eventIdRegisteredFor() == eventId) {
+            attendeeIdToCancel = att.attendeeId();
             break;
         }
     }
@@ -1567,11 +5142,11 @@ void System::cancelOwnRegistration() {
     if (attendeeIdToCancel != -1) {
         event->removeAttendee(attendeeIdToCancel); // Remove from event's list
         // Remove from master attendees list
-        allAttendees.erase(remove_if(allAttendees.begin(), allAttendees.end(),
-            [&](const Attendee& att){ return att.attendeeId == attendeeIdToCancel; }), allAttendees.end());
+        eraseAttendeeRecord(attendeeIdToCancel);
         cout << "Your registration for event '" << event->name << "' has been canceled.\n";
-        saveEvents();
-        saveAttendees();
+        recordChange("REG-," + to_string(eventId) + "," + to_string(attendeeIdToCancel));
+        recordChange("ATTENDEE-," + to_string(attendeeIdToCancel));
+        commitJournal();
     } else {
         cout << "You are not registered for event '" << event->name << "'.\n";
     }
@@ -1585,13 +5160,13 @@ void System::viewAttendeeListsPerEvent() const {
     }
     for (const auto& event : events) {
         cout << "Event: " << event.name << " (ID: " << event.eventId << ")\n";
-        if (event.attendeeIds.empty()) {
+        if (event.details->attendeeIds.empty()) {
             cout << "  No attendees registered.\n";
         } else {
-            for (int attId : event.attendeeIds) {
-                const Attendee* att = findAttendeeInMasterList(attId);
+            for (int attId : event.details->attendeeIds) {
+                AttendeeView att = findAttendeeInMasterList(attId);
                 if (att) {
-                    cout << "    - " << att->name << " (ID: " << att->attendeeId << ", Contact: " << att->contactInfo << ", Checked-in: " << (att->isCheckedIn ? "Yes" : "No") << ")\n";
+                    cout << "    - " << att.name() << " (ID: " << att.attendeeId() << ", Contact: " << att.contactInfo() << ", Checked-in: " << (att.isCheckedIn() ? "Yes" : "No") << ")\n";
                 } else {
                     cout << "    - Unknown Attendee (ID: " << attId << ")\n";
                 }
@@ -1601,24 +5176,25 @@ void System::viewAttendeeListsPerEvent() const {
     }
 }
 void System::checkInAttendeeForEvent() {
-    int eventId = getPositiveIntInput("Enter Event ID: ");
+    int eventId = getEventIdInput("Enter Event ID: ");
     Event* event = findEventById(eventId);
     if (!event) {
         cout << "Event with ID " << eventId << " not found.\n";
         return;
     }
     int attendeeId = getPositiveIntInput("Enter Attendee ID to check-in: ");
-    Attendee* attendee = findAttendeeInMasterList(attendeeId);
+    AttendeeRef attendee = findAttendeeInMasterList(attendeeId);
 
-    if (attendee && attendee->eventIdRegisteredFor == eventId) {
-        attendee->checkIn();
-        saveAttendees();
+    if (attendee && attendee.eventIdRegisteredFor() == eventId) {
+        attendee.checkIn();
+        recordChange("CHECKIN," + to_string(attendeeId));
+        commitJournal();
     } else {
         cout << "Attendee ID " << attendeeId << " not found or not registered for event ID " << eventId << ".\n";
     }
 }
 void System::generateAttendanceReportForEvent() const {
-    int eventId = getPositiveIntInput("Enter Event ID for attendance report: ");
+    int eventId = getEventIdInput("Enter Event ID for attendance report: ");
     const Event* event = findEventById(eventId);
     if (!event) {
         cout << "Event with ID " << eventId << " not found.\n";
@@ -1626,31 +5202,32 @@ void System::generateAttendanceReportForEvent() const {
     }
 
     cout << "\n--- Attendance Report for Event: " << event->name << " (ID: " << event->eventId << ") ---\n";
-    if (event->attendeeIds.empty()) {
+    if (event->details->attendeeIds.empty()) {
         cout << "No attendees registered for this event.\n";
         return;
     }
 
-    int checkedInCount = 0;
+    vector<uint32_t> attendeeSlotsOfEvent;
+    attendeeSlotsOfEvent.reserve(event->details->attendeeIds.size());
     cout << "Registered Attendees:\n";
-    for (int attId : event->attendeeIds) {
-        const Attendee* att = findAttendeeInMasterList(attId);
+    for (int attId : event->details->attendeeIds) {
+        auto slot = attendeeSlots.find(attId);
+        AttendeeView att = slot == attendeeSlots.end() ? AttendeeView() : allAttendees.get(slot->second);
         if (att) {
-            cout << "  - Name: " << att->name << ", Contact: " << att->contactInfo << ", Checked-in: " << (att->isCheckedIn ? "Yes" : "No") << "\n";
-            if (att->isCheckedIn) {
-                checkedInCount++;
-            }
+            cout << "  - Name: " << att.name() << ", Contact: " << att.contactInfo() << ", Checked-in: " << (att.isCheckedIn() ? "Yes" : "No") << "\n";
+            attendeeSlotsOfEvent.push_back(slot->second.index);
         } else {
             cout << "  - Unknown Attendee (ID: " << attId << ")\n";
         }
     }
+    size_t checkedInCount = allAttendees.checkedInCount(move(attendeeSlotsOfEvent));
     cout << "--------------------------------------\n";
-    cout << "Total Registered: " << event->attendeeIds.size() << "\n";
+    cout << "Total Registered: " << event->details->attendeeIds.size() << "\n";
     cout << "Total Checked-in: " << checkedInCount << "\n";
-    cout << "Attendance Percentage: " << (event->attendeeIds.empty() ? 0.0 : (static_cast<double>(checkedInCount) / event->attendeeIds.size()) * 100.0) << "%\n";
+    cout << "Attendance Percentage: " << (event->details->attendeeIds.empty() ? 0.0 : (static_cast<double>(checkedInCount) / event->details->attendeeIds.size()) * 100.0) << "%\n";
 }
 void System::exportAttendeeListForEventToFile() const {
-    int eventId = getPositiveIntInput("Enter Event ID to export attendee list: ");
+    int eventId = getEventIdInput("Enter Event ID to export attendee list: ");
     const Event* event = findEventById(eventId);
     if (!event) {
         cout << "Event with ID " << eventId << " not found.\n";
@@ -1665,16 +5242,16 @@ void System::exportAttendeeListForEventToFile() const {
     }
 
     outFile << "Attendee List for Event: " << event->name << " (ID: " << event->eventId << ")\n";
-    outFile << "Date: " << event->date << " Time: " << event->time << "\n";
+    outFile << "Date: " << event->dateText() << " Time: " << event->timeText() << "\n";
     outFile << "---------------------------------------------------------\n";
-    if (event->attendeeIds.empty()) {
+    if (event->details->attendeeIds.empty()) {
         outFile << "No attendees registered for this event.\n";
     } else {
         outFile << "ID,Name,ContactInfo,CheckedInStatus\n";
-        for (int attId : event->attendeeIds) {
-            const Attendee* att = findAttendeeInMasterList(attId);
+        for (int attId : event->details->attendeeIds) {
+            AttendeeView att = findAttendeeInMasterList(attId);
             if (att) {
-                outFile << att->attendeeId << "," << att->name << "," << att->contactInfo << "," << (att->isCheckedIn ? "Checked In" : "Not Checked In") << "\n";
+                outFile << att.attendeeId() << "," << att.name() << "," << att.contactInfo() << "," << (att.isCheckedIn() ? "Checked In" : "Not Checked In") << "\n";
             }
         }
     }
@@ -1682,29 +5259,226 @@ void System::exportAttendeeListForEventToFile() const {
     cout << "Attendee list for event '" << event->name << "' exported to " << filename << endl;
 }
 
+vector<AttendeeView> System::scanAttendeeContacts(const string& text, ScanStats& stats) const {
+    string needle = toLower(text);
+    vector<AttendeeView> found;
+    for (size_t pos : parallelScan(allAttendees, [&](const AttendeeView& att) { return containsIgnoreCase(att.contactInfo(), needle); }, stats)) {
+        found.push_back(allAttendees.atSlot(pos));
+    }
+    return found;
+}
+void System::searchAttendeesByContact() const {
+    string text = getStringInput("Enter part of the contact info to search for: ");
+    ScanStats stats;
+    vector<AttendeeView> found = scanAttendeeContacts(text, stats);
+    cout << "\n--- Attendees Matching '" << text << "' ---\n";
+    for (const AttendeeView& att : found) att.displayDetails();
+    if (found.empty()) cout << "No attendees found.\n";
+    printScanStats(stats, found.size());
+}
+
+vector<int> System::registeredUserIds(int eventId) const {
+    vector<int> userIds;
+    const Event* event = findEventById(eventId);
+    if (!event) return userIds;
+    userIds.reserve(event->details->attendeeIds.size());
+    for (int attId : event->details->attendeeIds) {
+        AttendeeView att = findAttendeeInMasterList(attId);
+        if (att && att.userId() > 0) userIds.push_back(att.userId());
+    }
+    sort(userIds.begin(), userIds.end());
+    userIds.erase(unique(userIds.begin(), userIds.end()), userIds.end());
+    return userIds;
+}
+vector<int> System::checkedInUserIds() const {
+    vector<int> userIds;
+    allAttendees.forEachCheckedIn([&](size_t slot) {
+        int userId = allAttendees.atSlot(slot).userId();
+        if (userId > 0) userIds.push_back(userId);
+    });
+    sort(userIds.begin(), userIds.end());
+    userIds.erase(unique(userIds.begin(), userIds.end()), userIds.end());
+    return userIds;
+}
+vector<int> System::combineEventRegistrations(int firstEventId, SetOperation op, int secondEventId) const {
+    vector<int> first = registeredUserIds(firstEventId);
+    vector<int> second = registeredUserIds(secondEventId);
+    switch (op) {
+        case SetOperation::BOTH: return intersectSorted(first, second);
+        case SetOperation::EITHER: return uniteSorted(first, second);
+        case SetOperation::FIRST_ONLY: return subtractSorted(first, second);
+    }
+    return {};
+}
+void System::compareEventRegistrations() const {
+    cout << "\n--- Compare Event Registrations ---\n";
+    cout << "1. Registered for both events\n";
+    cout << "2. Registered for either event\n";
+    cout << "3. Registered for the first event but not the second\n";
+    cout << "4. Registered for an event but never checked in anywhere\n";
+    int choice = getIntInput("Enter your choice: ");
+    if (choice < 1 || choice > 4) {
+        cout << "Invalid choice. Please enter 1 to 4.\n";
+        return;
+    }
+    int firstEventId = getEventIdInput(choice == 4 ? "Enter Event ID: " : "Enter first Event ID: ");
+    const Event* firstEvent = findEventById(firstEventId);
+    if (!firstEvent) {
+        cout << "Event with ID " << firstEventId << " not found.\n";
+        return;
+    }
+    vector<int> userIds;
+    string title;
+    if (choice == 4) {
+        userIds = subtractSorted(registeredUserIds(firstEventId), checkedInUserIds());
+        title = "Registered for '" + firstEvent->name + "' but never checked in";
+    } else {
+        int secondEventId = getEventIdInput("Enter second Event ID: ");
+        const Event* secondEvent = findEventById(secondEventId);
+        if (!secondEvent) {
+            cout << "Event with ID " << secondEventId << " not found.\n";
+            return;
+        }
+        const SetOperation ops[] = { SetOperation::BOTH, SetOperation::EITHER, SetOperation::FIRST_ONLY };
+        const char* joins[] = { "' and '", "' or '", "' but not '" };
+        userIds = combineEventRegistrations(firstEventId, ops[choice - 1], secondEventId);
+        title = "Registered for '" + firstEvent->name + joins[choice - 1] + secondEvent->name + "'";
+    }
+
+    cout << "\n--- " << title << " ---\n";
+    if (userIds.empty()) {
+        cout << "No users.\n";
+        return;
+    }
+    unordered_map<int, const User*> usersById;
+    for (const User* u : users) if (u) usersById.emplace(u->getUserId(), u);
+    for (int userId : userIds) {
+        auto it = usersById.find(userId);
+        cout << "  - " << (it != usersById.end() ? it->second->getUsername() : "Unknown user") << " (User ID: " << userId << ")\n";
+    }
+    cout << "Total: " << userIds.size() << " user(s)\n";
+}
+void System::runAttendeeQuery() const {
+    cout << "\n--- Query Attendees ---\n";
+    vector<QueryPredicate> conditions;
+    int choice;
+    do {
+        cout << "Add a condition (attendees must match all of them):\n";
+        cout << "1. Registered for Event ID\n";
+        cout << "2. Name contains\n";
+        cout << "3. Contact info contains\n";
+        cout << "4. Checked in\n";
+        cout << "5. Not checked in\n";
+        cout << "0. Run query\n";
+        choice = getIntInput("Enter your choice: ");
+        switch (choice) {
+            case 1: conditions.push_back(QueryPredicate::equals(QueryField::EVENT_ID, getEventIdInput("Event ID: "))); break;
+            case 2: conditions.push_back(QueryPredicate::contains(QueryField::NAME, getStringInput("Name contains: "))); break;
+            case 3: conditions.push_back(QueryPredicate::contains(QueryField::CONTACT, getStringInput("Contact info contains: "))); break;
+            case 4: conditions.push_back(QueryPredicate::equals(QueryField::CHECKED_IN, 1)); break;
+            case 5: conditions.push_back(QueryPredicate::equals(QueryField::CHECKED_IN, 0)); break;
+            case 0: break;
+            default: cout << "Invalid choice. Please try again.\n"; break;
+        }
+    } while (choice != 0);
+
+    QueryOptions options;
+    cout << "Sort by: 1. ID  2. Name  3. Event ID\n";
+    switch (getIntInput("Enter your choice: ")) {
+        case 2: options.orderBy = QueryField::NAME; break;
+        case 3: options.orderBy = QueryField::EVENT_ID; break;
+        default: options.orderBy = QueryField::ID; break;
+    }
+    options.descending = getIntInput("Order: 1. Ascending  2. Descending: ") == 2;
+    options.limit = static_cast<size_t>(max(0, getIntInput("Maximum results (0 for all): ")));
+
+    cout << "\n--- Query Results ---\n";
+    size_t count = 0;
+    string plan = queryAttendees(QueryPredicate::allOf(std::move(conditions)), options, [&](const AttendeeView& att) {
+        att.displayDetails();
+        ++count;
+    });
+    if (count == 0) cout << "No attendees match.\n";
+    cout << count << " result(s); plan: " << plan << ".\n";
+}
+
 InventoryItem* System::findInventoryItemById(int itemId) {
-    for (auto& item : inventory) if (item.itemId == itemId) return &item; return nullptr;
+    auto it = inventorySlots.find(itemId);
+    return it == inventorySlots.end() ? nullptr : inventory.get(it->second);
 }
 const InventoryItem* System::findInventoryItemById(int itemId) const {
-    for (const auto& item : inventory) if (item.itemId == itemId) return &item; return nullptr;
+    auto it = inventorySlots.find(itemId);
+    return it == inventorySlots.end() ? nullptr : inventory.get(it->second);
+}
+
+InventoryItem& System::insertInventoryItem(InventoryItem item) {
+    SlotMap<InventoryItem>::Handle handle = inventory.insert(std::move(item));
+    InventoryItem& added = *inventory.get(handle);
+    inventorySlots.emplace(added.itemId, handle);
+    inventoryNameSlots.emplace(added.nameKey, handle);
+    inventoryNames.insert(added.name, added.itemId);
+    return added;
+}
+void System::rebuildInventoryIndex() {
+    inventorySlots.clear();
+    inventoryNameSlots.clear();
+    inventoryNames.clear();
+    inventorySlots.reserve(inventory.size());
+    inventoryNameSlots.reserve(inventory.size());
+    for (auto it = inventory.begin(); it != inventory.end(); ++it) {
+        inventorySlots.emplace(it->itemId, it.handle());
+        inventoryNameSlots.emplace(it->nameKey, it.handle());
+        inventoryNames.insert(it->name, it->itemId);
+    }
+}
+void System::renameInventoryItem(InventoryItem& item, const string& newName) {
+    auto byId = inventorySlots.find(item.itemId);
+    auto old = inventoryNameSlots.find(item.nameKey);
+    if (old != inventoryNameSlots.end() && inventory.get(old->second) == &item) {
+        inventoryNameSlots.erase(old);
+        // Older data files may hold several items with this name; hand the key to the next one
+        for (auto it = inventory.begin(); it != inventory.end(); ++it) {
+            if (&*it != &item && it->nameKey == item.nameKey) {
+                inventoryNameSlots.emplace(it->nameKey, it.handle());
+                break;
+            }
+        }
+    }
+    inventoryNames.remove(item.name, item.itemId);
+    item.setName(newName);
+    if (byId != inventorySlots.end() && inventory.get(byId->second) == &item) {
+        inventoryNameSlots.emplace(item.nameKey, byId->second);
+    } else {
+        for (auto it = inventory.begin(); it != inventory.end(); ++it) { // A duplicate id: find the record's handle
+            if (&*it == &item) { inventoryNameSlots.emplace(item.nameKey, it.handle()); break; }
+        }
+    }
+    inventoryNames.insert(item.name, item.itemId);
 }
 InventoryItem* System::findInventoryItemByName(const string& name) {
-    for (auto& item : inventory) if (toLower(item.name) == toLower(name)) return &item; return nullptr;
+    auto it = inventoryNameSlots.find(name);
+    return it == inventoryNameSlots.end() ? nullptr : inventory.get(it->second);
 }
 const InventoryItem* System::findInventoryItemByName(const string& name) const {
-    for (const auto& item : inventory) if (toLower(item.name) == toLower(name)) return &item; return nullptr;
+    auto it = inventoryNameSlots.find(name);
+    return it == inventoryNameSlots.end() ? nullptr : inventory.get(it->second);
 }
 void System::addInventoryItem() {
     cout << "\n--- Add New Inventory Item ---\n";
     string name = getStringInput("Item Name: ");
+    if (const InventoryItem* existing = findInventoryItemByName(name)) {
+        cout << "An item named '" << existing->name << "' already exists (ID: " << existing->itemId << "). Update its quantity instead.\n";
+        return;
+    }
     int quantity = getPositiveIntInput("Total Quantity: ");
     string desc = getStringInput("Description: ");
-    inventory.emplace_back(name, quantity, desc);
-    cout << "Inventory item '" << name << "' added (ID: " << inventory.back().itemId << ").\n";
-    saveInventory();
+    const InventoryItem& added = insertInventoryItem(InventoryItem(name, quantity, InternedString(desc)));
+    cout << "Inventory item '" << name << "' added (ID: " << added.itemId << ").\n";
+    recordChange("ITEM+," + added.toString());
+    commitJournal();
 }
 void System::updateInventoryItemDetails() {
-    int itemId = getPositiveIntInput("Enter Item ID to update: ");
+    int itemId = getInventoryItemIdInput("Enter Item ID to update: ");
     InventoryItem* item = findInventoryItemById(itemId);
     if (!item) {
         cout << "Inventory item with ID " << itemId << " not found.\n";
@@ -1719,14 +5493,27 @@ void System::updateInventoryItemDetails() {
     string new_str_val;
     int new_int_val;
     switch (choice) {
-        case 1: new_str_val = getStringInput("Enter new name: "); item->name = new_str_val; break;
-        case 2: new_int_val = getPositiveIntInput("Enter new total quantity: "); item->setTotalQuantity(new_int_val); break;
-        case 3: new_str_val = getStringInput("Enter new description: "); item->description = new_str_val; break;
+        case 1: {
+            new_str_val = getStringInput("Enter new name: ");
+            const InventoryItem* existing = findInventoryItemByName(new_str_val);
+            if (existing && existing != item) {
+                cout << "An item named '" << existing->name << "' already exists (ID: " << existing->itemId << "). No changes made.\n";
+                return;
+            }
+            renameInventoryItem(*item, new_str_val);
+            break;
+        }
+        case 2:
+            new_int_val = getPositiveIntInput("Enter new total quantity: ");
+            if (!item->setTotalQuantity(new_int_val)) return;
+            break;
+        case 3: new_str_val = getStringInput("Enter new description: "); item->description = InternedString(new_str_val); break;
         case 4: return;
         default: cout << "Invalid choice. No changes made.\n"; return;
     }
     cout << "Inventory item updated successfully.\n";
-    saveInventory();
+    recordChange("ITEM+," + item->toString());
+    commitJournal();
 }
 void System::viewAllInventoryItems() const {
     cout << "\n--- All Inventory Items ---\n";
@@ -1734,7 +5521,7 @@ void System::viewAllInventoryItems() const {
     for (const auto& item : inventory) item.displayDetails();
 }
 void System::trackInventoryAllocationToEvent() {
-    int eventId = getPositiveIntInput("Enter Event ID: ");
+    int eventId = getEventIdInput("Enter Event ID: ");
     Event* event = findEventById(eventId);
     if (!event) {
         cout << "Event with ID " << eventId << " not found.\n";
@@ -1747,7 +5534,7 @@ void System::trackInventoryAllocationToEvent() {
     int choice = getIntInput("Enter your choice: ");
 
     if (choice == 1) {
-        int itemId = getPositiveIntInput("Enter Inventory Item ID to allocate: ");
+        int itemId = getInventoryItemIdInput("Enter Inventory Item ID to allocate: ");
         InventoryItem* item = findInventoryItemById(itemId);
         if (!item) {
             cout << "Inventory item with ID " << itemId << " not found.\n";
@@ -1758,18 +5545,18 @@ void System::trackInventoryAllocationToEvent() {
         if (item->allocate(quantity)) {
             event->allocateInventoryItem(item->itemId, quantity);
             cout << quantity << " of '" << item->name << "' allocated to event '" << event->name << "'.\n";
-            saveInventory();
-            saveEvents();
+            recordChange("ALLOC," + to_string(eventId) + "," + to_string(itemId) + "," + to_string(event->details->allocatedInventory[itemId]));
+            commitJournal();
         }
     } else if (choice == 2) {
-        int itemId = getPositiveIntInput("Enter Inventory Item ID to deallocate: ");
+        int itemId = getInventoryItemIdInput("Enter Inventory Item ID to deallocate: ");
         InventoryItem* item = findInventoryItemById(itemId);
         if (!item) {
             cout << "Inventory item with ID " << itemId << " not found.\n";
             return;
         }
-        auto it = event->allocatedInventory.find(itemId);
-        if (it == event->allocatedInventory.end()) {
+        auto it = event->details->allocatedInventory.find(itemId);
+        if (it == event->details->allocatedInventory.end()) {
             cout << "'" << item->name << "' was not allocated to event '" << event->name << "'.\n";
             return;
         }
@@ -1779,8 +5566,10 @@ void System::trackInventoryAllocationToEvent() {
         if (actualDeallocated > 0) {
             item->deallocate(actualDeallocated);
             cout << actualDeallocated << " of '" << item->name << "' deallocated from event '" << event->name << "'.\n";
-            saveInventory();
-            saveEvents();
+            auto remaining = event->details->allocatedInventory.find(itemId);
+            int remainingQty = (remaining == event->details->allocatedInventory.end()) ? 0 : remaining->second;
+            recordChange("ALLOC," + to_string(eventId) + "," + to_string(itemId) + "," + to_string(remainingQty));
+            commitJournal();
         } else {
             cout << "No quantity deallocated.\n";
         }
@@ -1821,7 +5610,7 @@ void System::generateFullInventoryReport() const {
         bool eventHasAllocations = false;
         stringstream ss;
         ss << "  Event: " << event.name << " (ID: " << event.eventId << ")\n";
-        for (const auto& pair : event.allocatedInventory) {
+        for (const auto& pair : event.details->allocatedInventory) {
             const InventoryItem* item = findInventoryItemById(pair.first);
             if (item && pair.second > 0) {
                 ss << "    - " << item->name << ": " << pair.second << " units\n";
@@ -1918,33 +5707,87 @@ void System::updateCurrentLoggedInUserContactInfo() {
     // Find the attendee profile associated with the current user.
     // Assuming a regular user primarily has one main attendee profile (eventIdRegisteredFor = 0 or similar generic).
     // Or, prompt them to choose which attendee profile to update if they have multiple.
-    Attendee* userAttendeeProfile = nullptr;
-    for (auto& att : allAttendees) {
-        if (toLower(att.name) == toLower(currentUser->getUsername()) && att.eventIdRegisteredFor == 0) { // Generic profile
-            userAttendeeProfile = &att;
+    AttendeeRef userAttendeeProfile;
+    for (const AttendeeRef& att : findRegistrationsOfUser(currentUser->getUserId())) {
+        if (att.eventIdRegisteredFor() == 0) { // Generic profile
+            userAttendeeProfile = att;
             break;
         }
         // If not found as generic, maybe they only have event-specific ones.
-        // For simplicity, let's update all associated with their name.
-        if (toLower(att.name) == toLower(currentUser->getUsername())) {
-             att.contactInfo = newContact;
-        }
+        // For simplicity, let's update all associated with their account.
+        att.setContactInfo(newContact);
+        recordChange("ATTENDEE+," + att.toString());
     }
 
     if (userAttendeeProfile) {
-        userAttendeeProfile->contactInfo = newContact;
+        userAttendeeProfile.setContactInfo(newContact);
+        recordChange("ATTENDEE+," + userAttendeeProfile.toString());
         cout << "Your primary attendee contact information has been updated.\n";
     } else {
         // If no generic attendee profile, offer to create one or update their first registered one.
         cout << "No generic attendee profile found for you. Creating one with new contact info.\n";
-        allAttendees.emplace_back(currentUser->getUsername(), newContact, 0); // Event ID 0 for generic
+        AttendeeView profile = insertAttendee(Attendee(currentUser->getUsername(), newContact, 0, currentUser->getUserId())); // Event ID 0 for generic
+        recordChange("ATTENDEE+," + profile.toString());
+    }
+    commitJournal();
+}
+
+
+// --- Allocation Map Benchmark ---
+// Compares FlatMap with std::map for Event::allocatedInventory. Not part of the application:
+// build with -DALLOCATION_MAP_BENCHMARK to get a binary that only runs this comparison.
+#ifdef ALLOCATION_MAP_BENCHMARK
+// Runs the allocation workload of eventCount events on one map type: each event allocates a
+// few items, then every allocation is looked up, walked the way the reports do, and released.
+// Adds what it read to checksum so the work cannot be optimized away; returns the seconds taken.
+template <typename AllocationMap>
+static double timeAllocationWorkload(size_t eventCount, long long& checksum) {
+    const int ITEMS_PER_EVENT = 3;
+    const int DISTINCT_ITEMS = 50;
+    auto itemFor = [&](size_t event, int i) { return static_cast<int>((event * 7 + i * 13) % DISTINCT_ITEMS) + 1; };
+    auto started = chrono::steady_clock::now();
+    {
+        vector<AllocationMap> allocations(eventCount);
+        for (size_t e = 0; e < eventCount; ++e) {
+            for (int i = 0; i < ITEMS_PER_EVENT; ++i) allocations[e][itemFor(e, i)] += i + 1;
+        }
+        for (size_t e = 0; e < eventCount; ++e) {
+            for (int i = 0; i < ITEMS_PER_EVENT; ++i) {
+                auto it = allocations[e].find(itemFor(e, i));
+                if (it != allocations[e].end()) checksum += it->second;
+            }
+        }
+        for (const auto& allocation : allocations) {
+            for (const auto& pair : allocation) checksum += static_cast<long long>(pair.first) * pair.second;
+        }
+        for (size_t e = 0; e < eventCount; ++e) {
+            for (int i = 0; i < ITEMS_PER_EVENT; ++i) allocations[e].erase(itemFor(e, i));
+        }
+    } // Freeing the maps is part of the cost
+    return chrono::duration<double>(chrono::steady_clock::now() - started).count();
+}
+static void benchmarkAllocationMaps() {
+    cout << "\n--- Allocation Map Benchmark (3 items per event) ---\n";
+    cout << left << setw(10) << "Events" << right << setw(16) << "std::map (ms)" << setw(16) << "FlatMap (ms)" << setw(10) << "Speedup" << "\n";
+    for (size_t eventCount : { size_t(10), size_t(1000), size_t(100000) }) {
+        long long treeChecksum = 0, flatChecksum = 0;
+        double treeSeconds = timeAllocationWorkload<map<int, int>>(eventCount, treeChecksum);
+        double flatSeconds = timeAllocationWorkload<FlatMap<int, int>>(eventCount, flatChecksum);
+        cout << left << setw(10) << eventCount << right << fixed << setprecision(3)
+             << setw(16) << treeSeconds * 1000.0 << setw(16) << flatSeconds * 1000.0
+             << setprecision(2) << setw(9) << (flatSeconds > 0.0 ? treeSeconds / flatSeconds : 0.0) << "x\n";
+        if (treeChecksum != flatChecksum) cerr << "Warning: The two maps disagree for " << eventCount << " events.\n";
     }
-    saveAttendees();
 }
+#endif
 
 
 // --- Main Function ---
 int main() {
+#ifdef ALLOCATION_MAP_BENCHMARK
+    benchmarkAllocationMaps();
+    return 0;
+#endif
     // Get the singleton instance of System
     System& eventSystem = System::getInstance();
 